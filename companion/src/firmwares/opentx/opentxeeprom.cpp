@@ -25,6 +25,7 @@
 #include "opentxeeprom.h"
 #include "customdebug.h"
 #include "opentxinterface.h"
+#include <QMutex>
 
 using namespace Board;
 
@@ -264,11 +265,13 @@ class SwitchesConversionTable: public ConversionTable {
     };
 
     static std::list<Cache> internalCache;
+    static QMutex internalCacheMutex; // models may be loaded from several threads
 
   public:
 
     static SwitchesConversionTable * getInstance(Board::Type board, unsigned int version, unsigned long flags=0)
     {
+      QMutexLocker locker(&internalCacheMutex);
       for (auto & element : internalCache) {
         if (element.board == board && element.version == version && element.flags == flags)
           return element.table;
@@ -288,6 +291,7 @@ class SwitchesConversionTable: public ConversionTable {
 };
 
 std::list<SwitchesConversionTable::Cache> SwitchesConversionTable::internalCache;
+QMutex SwitchesConversionTable::internalCacheMutex;
 
 #define FLAG_NONONE       0x01
 #define FLAG_NOSWITCHES   0x02
@@ -393,11 +397,13 @@ class SourcesConversionTable: public ConversionTable {
         SourcesConversionTable * table;
     };
     static std::list<Cache> internalCache;
+    static QMutex internalCacheMutex; // models may be loaded from several threads
 
   public:
 
     static SourcesConversionTable * getInstance(Board::Type board, unsigned int version, unsigned int variant, unsigned long flags=0)
     {
+      QMutexLocker locker(&internalCacheMutex);
       for (std::list<Cache>::iterator it=internalCache.begin(); it!=internalCache.end(); it++) {
         Cache & element = *it;
         if (element.board == board && element.version == version && element.variant == variant && element.flags == flags)
@@ -420,6 +426,7 @@ class SourcesConversionTable: public ConversionTable {
 };
 
 std::list<SourcesConversionTable::Cache> SourcesConversionTable::internalCache;
+QMutex SourcesConversionTable::internalCacheMutex;
 
 void OpenTxEepromCleanup(void)
 {
@@ -125,19 +125,29 @@ bool OpenTxEepromInterface::loadRadioSettingsFromRLE(GeneralSettings & settings,
   }
 }
 
-bool OpenTxEepromInterface::loadModelFromRLE(ModelData & model, RleFile * rleFile, unsigned int index, uint8_t version, uint32_t variant)
+bool OpenTxEepromInterface::loadModelsFromRLE(std::vector<ModelData> & models, RleFile * rleFile, uint8_t version, uint32_t variant)
 {
-  QByteArray data(sizeof(model), 0);  // ModelData should be always bigger than the EEPROM struct
-  rleFile->openRd(FILE_MODEL(index));
-  int size = rleFile->readRlc2((uint8_t *)data.data(), data.size());
-  if (size) {
-    if (loadFromByteArray<ModelData, OpenTxModelData>(model, data, version, variant)) {
-      model.used = true;
+  // the RLE file system is read one model after the other, the models are
+  // then decoded concurrently as they are independent from each other
+  QList<std::function<void()>> jobs;
+  int count = std::min<int>(firmware->getCapability(Models), models.size());
+  for (int i = 0; i < count; i++) {
+    ModelData * model = &models[i];
+    QByteArray data(sizeof(ModelData), 0);  // ModelData should be always bigger than the EEPROM struct
+    rleFile->openRd(FILE_MODEL(i));
+    int size = rleFile->readRlc2((uint8_t *)data.data(), data.size());
+    if (size) {
+      jobs.append([this, model, data, version, variant]() {
+        if (loadFromByteArray<ModelData, OpenTxModelData>(*model, data, version, variant)) {
+          model->used = true;
+        }
+      });
+    }
+    else {
+      model->clear();
     }
   }
-  else {
-    model.clear();
-  }
+  runInParallel(jobs);
   return true;
 }
 
@@ -263,15 +273,10 @@ unsigned long OpenTxEepromInterface::load(RadioData &radioData, const uint8_t *
   if (getCurrentFirmware()->getCapability(Models) == 0) {
     radioData.models.resize(firmware->getCapability(Models));
   }
-  for (int i = 0; i < firmware->getCapability(Models); i++) {
-    if (i < (int)radioData.models.size() && !loadModelFromRLE(radioData.models[i], efile, i, version, radioData.generalSettings.variant)) {
-      dbg << " ko";
-      errors.set(UNKNOWN_ERROR);
-      if (getCurrentFirmware()->getCapability(Models) == 0) {
-        radioData.models.resize(i);
-      }
-      return errors.to_ulong();
-    }
+  if (!loadModelsFromRLE(radioData.models, efile, version, radioData.generalSettings.variant)) {
+    dbg << " ko";
+    errors.set(UNKNOWN_ERROR);
+    return errors.to_ulong();
   }
   dbg << " ok";
   errors.set(ALL_OK);
@@ -70,7 +70,7 @@ class OpenTxEepromInterface : public EEPROMInterface
 
     bool loadRadioSettingsFromRLE(GeneralSettings & settings, RleFile * rleFile, uint8_t version);
 
-    bool loadModelFromRLE(ModelData & model, RleFile * rleFile, unsigned int index, uint8_t version, uint32_t variant);
+    bool loadModelsFromRLE(std::vector<ModelData> & models, RleFile * rleFile, uint8_t version, uint32_t variant);
 
     void showErrors(const QString & title, const QStringList & errors);
 
@@ -0,0 +1,508 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "logindex.h"
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <limits>
+
+static inline bool isBlank(char c)
+{
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static inline bool isDigit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+static bool parseNumber(const char * & str, const char * end, int digits, int & result)
+{
+  result = 0;
+  for (int i = 0; i < digits; i++, str++) {
+    if (str >= end || !isDigit(*str))
+      return false;
+    result = result * 10 + (*str - '0');
+  }
+  return true;
+}
+
+// "yyyy-MM-dd"
+static bool parseDate(const char * str, int len, QDate & date)
+{
+  const char * end = str + len;
+  int year, month, day;
+  if (!parseNumber(str, end, 4, year) || str >= end || *str++ != '-' ||
+      !parseNumber(str, end, 2, month) || str >= end || *str++ != '-' ||
+      !parseNumber(str, end, 2, day) || str != end) {
+    return false;
+  }
+  date = QDate(year, month, day);
+  return date.isValid();
+}
+
+// "HH:mm:ss" or "HH:mm:ss.zzz", in seconds since midnight
+static bool parseTime(const char * str, int len, double & secs)
+{
+  const char * end = str + len;
+  int hours, minutes, seconds;
+  if (!parseNumber(str, end, 2, hours) || str >= end || *str++ != ':' ||
+      !parseNumber(str, end, 2, minutes) || str >= end || *str++ != ':' ||
+      !parseNumber(str, end, 2, seconds)) {
+    return false;
+  }
+  secs = hours * 3600 + minutes * 60 + seconds;
+  if (str < end && *str == '.') {
+    double scale = 0.1;
+    for (str++; str < end && isDigit(*str); str++, scale /= 10) {
+      secs += (*str - '0') * scale;
+    }
+  }
+  return str == end;
+}
+
+LogIndex::LogIndex():
+  data(NULL),
+  size(0),
+  headerLength(0),
+  lines(0),
+  errors(0)
+{
+}
+
+LogIndex::~LogIndex()
+{
+  close();
+}
+
+void LogIndex::close()
+{
+  if (data) {
+    file.unmap((uchar *)data);
+    data = NULL;
+  }
+  file.close();
+  size = 0;
+  headerLength = 0;
+  lines = 0;
+  errors = 0;
+  header.clear();
+  offsets.clear();
+  times.clear();
+  pyramid.clear();
+}
+
+bool LogIndex::open(const QString & filename)
+{
+  close();
+
+  file.setFileName(filename);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+  size = file.size();
+  if (size > 0) {
+    data = (const char *)file.map(0, size);
+  }
+  if (!data) {
+    close();
+    return false;
+  }
+
+  const char * end = data + size;
+  const char * eol = (const char *)memchr(data, '\n', size);
+  if (!eol) {
+    eol = end;
+  }
+  headerLength = eol - data;
+  while (headerLength > 0 && isBlank(data[headerLength - 1])) {
+    headerLength--;
+  }
+  QByteArray headerLine = QByteArray::fromRawData(data, headerLength);
+  if (!headerLine.startsWith("Date,Time")) {
+    close();
+    return false;
+  }
+  header = QString::fromUtf8(headerLine).split(',');
+
+  int numfields = header.size();
+  pyramid.resize(numfields);
+  for (int column = 2; column < numfields; column++) {
+    pyramid[column].resize(1);
+  }
+
+  QVarLengthArray<const char *, 64> fields;
+  QDate lastDate;
+  double midnight = 0;
+
+  for (const char * line = eol + 1; line < end; line = eol + 1) {
+    eol = (const char *)memchr(line, '\n', end - line);
+    if (!eol) {
+      eol = end;
+    }
+
+    const char * start = line;
+    const char * stop = eol;
+    while (start < stop && isBlank(*start)) start++;
+    while (stop > start && isBlank(stop[-1])) stop--;
+    lines++;
+
+    // fields[i] is the start of field i, fields[count] is one past the end of the row
+    fields.clear();
+    fields.append(start);
+    for (const char * c = start; c < stop; c++) {
+      if (*c == ',') {
+        fields.append(c + 1);
+      }
+    }
+    fields.append(stop + 1);
+    if (fields.size() - 1 != numfields) {
+      errors++;
+      continue;
+    }
+
+    QDate date;
+    double secs;
+    if (!parseDate(fields[0], fields[1] - fields[0] - 1, date) ||
+        !parseTime(fields[1], fields[2] - fields[1] - 1, secs)) {
+      errors++;
+      continue;
+    }
+    if (date != lastDate) {
+      lastDate = date;
+      midnight = QDateTime(date, QTime(0, 0)).toMSecsSinceEpoch() / 1000.0;
+    }
+
+    int row = offsets.size();
+    offsets.append(start - data);
+    times.append(midnight + secs);
+    for (int column = 2; column < numfields; column++) {
+      addBucketValue(column, row, parseValue(fields[column], fields[column + 1] - fields[column] - 1));
+    }
+  }
+
+  buildPyramid();
+  return true;
+}
+
+void LogIndex::addBucketValue(int column, int row, double value)
+{
+  QVector<Bucket> & level = pyramid[column][0];
+  if (row % LOG_BUCKET_ROWS == 0) {
+    Bucket bucket = { (float)value, (float)value };
+    level.append(bucket);
+  }
+  else {
+    Bucket & bucket = level.last();
+    if (value < bucket.min) bucket.min = value;
+    if (value > bucket.max) bucket.max = value;
+  }
+}
+
+void LogIndex::buildPyramid()
+{
+  for (int column = 2; column < pyramid.size(); column++) {
+    QVector<QVector<Bucket> > & levels = pyramid[column];
+    while (levels.last().size() > 1) {
+      const QVector<Bucket> & below = levels.last();
+      QVector<Bucket> level;
+      level.reserve((below.size() + LOG_PYRAMID_FANOUT - 1) / LOG_PYRAMID_FANOUT);
+      for (int i = 0; i < below.size(); i++) {
+        if (i % LOG_PYRAMID_FANOUT == 0) {
+          level.append(below.at(i));
+        }
+        else {
+          Bucket & bucket = level.last();
+          bucket.min = std::min(bucket.min, below.at(i).min);
+          bucket.max = std::max(bucket.max, below.at(i).max);
+        }
+      }
+      levels.append(level);
+    }
+  }
+}
+
+QByteArray LogIndex::rawHeader() const
+{
+  return QByteArray(data, headerLength);
+}
+
+int LogIndex::rowLength(int row) const
+{
+  const char * start = rowStart(row);
+  const char * end = (const char *)memchr(start, '\n', data + size - start);
+  if (!end) {
+    end = data + size;
+  }
+  while (end > start && isBlank(end[-1])) {
+    end--;
+  }
+  return end - start;
+}
+
+QByteArray LogIndex::rawRow(int row) const
+{
+  return QByteArray(rowStart(row), rowLength(row));
+}
+
+QStringList LogIndex::row(int row) const
+{
+  return QString::fromUtf8(rowStart(row), rowLength(row)).split(',');
+}
+
+bool LogIndex::fieldAt(int row, int column, const char ** str, int * len) const
+{
+  const char * start = rowStart(row);
+  const char * end = start + rowLength(row);
+  for (int i = 0; i < column; i++) {
+    start = (const char *)memchr(start, ',', end - start);
+    if (!start) {
+      return false;
+    }
+    start++;
+  }
+  const char * comma = (const char *)memchr(start, ',', end - start);
+  *str = start;
+  *len = (comma ? comma : end) - start;
+  return true;
+}
+
+QString LogIndex::field(int row, int column) const
+{
+  const char * str;
+  int len;
+  if (!fieldAt(row, column, &str, &len)) {
+    return QString();
+  }
+  return QString::fromUtf8(str, len);
+}
+
+double LogIndex::value(int row, int column) const
+{
+  const char * str;
+  int len;
+  if (!fieldAt(row, column, &str, &len)) {
+    return 0;
+  }
+  return parseValue(str, len);
+}
+
+// Same results as QString::toDouble() for the values found in logs (0 when
+// the field is not a number), without the conversion to QString
+double LogIndex::parseValue(const char * str, int len)
+{
+  const char * end = str + len;
+  while (str < end && isBlank(*str)) str++;
+  while (end > str && isBlank(end[-1])) end--;
+
+  bool negative = false;
+  if (str < end && (*str == '-' || *str == '+')) {
+    negative = (*str++ == '-');
+  }
+
+  double result = 0;
+  int digits = 0;
+  int exponent = 0;
+  for (; str < end && isDigit(*str); str++, digits++) {
+    result = result * 10 + (*str - '0');
+  }
+  if (str < end && *str == '.') {
+    for (str++; str < end && isDigit(*str); str++, digits++) {
+      result = result * 10 + (*str - '0');
+      exponent--;
+    }
+  }
+  if (digits == 0) {
+    return 0;
+  }
+
+  if (str < end && (*str == 'e' || *str == 'E')) {
+    str++;
+    bool negativeExponent = false;
+    if (str < end && (*str == '-' || *str == '+')) {
+      negativeExponent = (*str++ == '-');
+    }
+    int value = 0;
+    const char * first = str;
+    for (; str < end && isDigit(*str) && value < 10000; str++) {
+      value = value * 10 + (*str - '0');
+    }
+    if (str == first) {
+      return 0;
+    }
+    exponent += negativeExponent ? -value : value;
+  }
+  if (str != end) {
+    return 0;
+  }
+
+  if (exponent < 0)
+    result /= pow(10.0, -exponent);
+  else if (exponent > 0)
+    result *= pow(10.0, exponent);
+  return negative ? -result : result;
+}
+
+int LogIndex::rowAt(double time) const
+{
+  return std::lower_bound(times.constBegin(), times.constEnd(), time) - times.constBegin();
+}
+
+bool LogIndex::minMax(int column, int first, int last, double & min, double & max) const
+{
+  if (column < 2 || column >= pyramid.size()) {
+    return false;
+  }
+
+  first = std::max(first, 0);
+  last = std::min(last, rowCount());
+  if (first >= last) {
+    return false;
+  }
+
+  const QVector<QVector<Bucket> > & levels = pyramid.at(column);
+  min = std::numeric_limits<double>::max();
+  max = -std::numeric_limits<double>::max();
+
+  int row = first;
+  while (row < last) {
+    // take the largest pyramid bucket starting at row and ending before last,
+    // rows which are not covered by any bucket are read from the file
+    int level = levels.size() - 1;
+    int rows = LOG_BUCKET_ROWS;
+    for (int i = 0; i < level; i++) {
+      rows *= LOG_PYRAMID_FANOUT;
+    }
+    for (; level >= 0; level--, rows /= LOG_PYRAMID_FANOUT) {
+      if (row % rows == 0 && std::min(row + rows, rowCount()) <= last) {
+        break;
+      }
+    }
+
+    if (level >= 0) {
+      const Bucket & bucket = levels.at(level).at(row / rows);
+      min = std::min(min, (double)bucket.min);
+      max = std::max(max, (double)bucket.max);
+      row = std::min(row + rows, rowCount());
+    }
+    else {
+      double y = value(row, column);
+      min = std::min(min, y);
+      max = std::max(max, y);
+      row++;
+    }
+  }
+
+  return true;
+}
+
+void LogIndex::appendSample(int row, int rows, double min, double max, QVector<double> & x, QVector<double> & y) const
+{
+  x.append(times.at(row));
+  y.append(min);
+  if (rows > 1) {
+    x.append(times.at(row + rows / 2));
+    y.append(max);
+  }
+}
+
+void LogIndex::sample(int column, int first, int last, int buckets, QVector<double> & x, QVector<double> & y) const
+{
+  first = std::max(first, 0);
+  last = std::min(last, rowCount());
+  if (column < 2 || column >= pyramid.size() || first >= last || buckets <= 0) {
+    return;
+  }
+
+  int span = last - first;
+  if (span <= 2 * buckets) {
+    // zoomed in enough to draw every row
+    for (int row = first; row < last; row++) {
+      x.append(times.at(row));
+      y.append(value(row, column));
+    }
+    return;
+  }
+
+  // large buckets are rounded up to whole pyramid buckets, so that they
+  // are computed from the pyramid without reading any row
+  int rows = (span + buckets - 1) / buckets;
+  if (rows >= LOG_BUCKET_ROWS) {
+    rows = (rows + LOG_BUCKET_ROWS - 1) / LOG_BUCKET_ROWS * LOG_BUCKET_ROWS;
+  }
+
+  for (int row = first; row < last; ) {
+    int end = std::min((row / rows + 1) * rows, last);
+    double min, max;
+    minMax(column, row, end, min, max);
+    appendSample(row, end - row, min, max, x, y);
+    row = end;
+  }
+}
+
+LogTableModel::LogTableModel(const LogIndex & logIndex, QObject * parent):
+  QAbstractTableModel(parent),
+  logIndex(logIndex),
+  cachedRow(-1)
+{
+}
+
+void LogTableModel::reload()
+{
+  beginResetModel();
+  cachedRow = -1;
+  cachedFields.clear();
+  endResetModel();
+}
+
+int LogTableModel::rowCount(const QModelIndex & parent) const
+{
+  return parent.isValid() ? 0 : logIndex.rowCount();
+}
+
+int LogTableModel::columnCount(const QModelIndex & parent) const
+{
+  return parent.isValid() ? 0 : logIndex.columnCount();
+}
+
+QVariant LogTableModel::data(const QModelIndex & index, int role) const
+{
+  if (!index.isValid() || role != Qt::DisplayRole) {
+    return QVariant();
+  }
+
+  if (index.row() != cachedRow) {
+    cachedFields = logIndex.row(index.row());
+    cachedRow = index.row();
+  }
+
+  return cachedFields.value(index.column());
+}
+
+QVariant LogTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+  if (orientation == Qt::Horizontal && role == Qt::DisplayRole) {
+    return logIndex.columns().value(section);
+  }
+
+  return QAbstractTableModel::headerData(section, orientation, role);
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _LOGINDEX_H_
+#define _LOGINDEX_H_
+
+#include <QtCore>
+#include <QAbstractTableModel>
+
+// Number of rows summarized by one bucket of the first pyramid level,
+// each further level groups LOG_PYRAMID_FANOUT buckets of the level below
+#define LOG_BUCKET_ROWS     64
+#define LOG_PYRAMID_FANOUT  4
+
+/*
+  Read-only view of a CSV telemetry log.
+
+  The file is memory mapped and scanned once: the scan records the offset
+  of every valid row, its timestamp, and a min/max pyramid of each data
+  column. Rows are only split into fields when they are displayed, and
+  plots are sampled from the pyramid at the resolution they are drawn at.
+*/
+class LogIndex
+{
+  public:
+    LogIndex();
+    ~LogIndex();
+
+    bool open(const QString & filename);
+    void close();
+
+    bool isEmpty() const { return offsets.isEmpty(); }
+    int rowCount() const { return offsets.size(); }
+    int columnCount() const { return header.size(); }
+    const QStringList & columns() const { return header; }
+    int lineCount() const { return lines; }
+    int invalidLineCount() const { return errors; }
+
+    QByteArray rawHeader() const;
+    QByteArray rawRow(int row) const;
+    QStringList row(int row) const;
+    QString field(int row, int column) const;
+    double value(int row, int column) const;
+
+    // seconds since epoch, local time, with the milliseconds as fraction
+    double timestamp(int row) const { return times.at(row); }
+    // first row whose timestamp is not before time
+    int rowAt(double time) const;
+
+    // min / max of a data column over rows [first, last)
+    bool minMax(int column, int first, int last, double & min, double & max) const;
+    // up to two points (min and max) for each of about buckets buckets over rows [first, last)
+    void sample(int column, int first, int last, int buckets, QVector<double> & x, QVector<double> & y) const;
+
+    static double parseValue(const char * str, int len);
+
+  protected:
+    struct Bucket {
+      float min;
+      float max;
+    };
+
+    const char * rowStart(int row) const { return data + offsets.at(row); }
+    int rowLength(int row) const;
+    bool fieldAt(int row, int column, const char ** str, int * len) const;
+    void addBucketValue(int column, int row, double value);
+    void buildPyramid();
+    void appendSample(int row, int rows, double min, double max, QVector<double> & x, QVector<double> & y) const;
+
+    QFile file;
+    const char * data;
+    qint64 size;
+    int headerLength;
+    int lines;
+    int errors;
+    QStringList header;
+    QVector<qint64> offsets;
+    QVector<double> times;
+    QVector<QVector<QVector<Bucket> > > pyramid; // [column][level][bucket]
+};
+
+class LogTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+  public:
+    explicit LogTableModel(const LogIndex & logIndex, QObject * parent = 0);
+
+    void reload();
+
+    virtual int rowCount(const QModelIndex & parent = QModelIndex()) const Q_DECL_OVERRIDE;
+    virtual int columnCount(const QModelIndex & parent = QModelIndex()) const Q_DECL_OVERRIDE;
+    virtual QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const Q_DECL_OVERRIDE;
+    virtual QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const Q_DECL_OVERRIDE;
+
+  private:
+    const LogIndex & logIndex;
+    // the view asks for every cell of a row in turn, keep the last split row
+    mutable int cachedRow;
+    mutable QStringList cachedFields;
+};
+
+#endif // _LOGINDEX_H_
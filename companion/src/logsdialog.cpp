@@ -37,11 +37,14 @@ LogsDialog::LogsDialog(QWidget *parent) :
   cursorB(0),
   cursorLine(0)
 {
-  csvlog.clear();
-
   ui->setupUi(this);
   setWindowIcon(CompanionIcon("logs.png"));
 
+  logModel = new LogTableModel(logIndex, this);
+  ui->logTable->setModel(logModel);
+  ui->logTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+  ui->logTable->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+
   plotLock=false;
 
   colors.append(Qt::green);
@@ -110,13 +113,15 @@ LogsDialog::LogsDialog(QWidget *parent) :
 
   // make left axes transfer its range to right axes:
   connect(axisRect->axis(QCPAxis::atLeft), SIGNAL(rangeChanged(QCPRange)), this, SLOT(yAxisChangeRanges(QCPRange)));
+  // resample the plots for the visible time range when zooming or dragging:
+  connect(axisRect->axis(QCPAxis::atBottom), SIGNAL(rangeChanged(QCPRange)), this, SLOT(xAxisChangeRange(QCPRange)));
 
   // connect some interaction slots:
   connect(ui->customPlot, SIGNAL(titleDoubleClick(QMouseEvent*, QCPPlotTitle*)), this, SLOT(titleDoubleClick(QMouseEvent*, QCPPlotTitle*)));
   connect(ui->customPlot, SIGNAL(axisDoubleClick(QCPAxis*,QCPAxis::SelectablePart,QMouseEvent*)), this, SLOT(axisLabelDoubleClick(QCPAxis*,QCPAxis::SelectablePart)));
   connect(ui->customPlot, SIGNAL(legendDoubleClick(QCPLegend*,QCPAbstractLegendItem*,QMouseEvent*)), this, SLOT(legendDoubleClick(QCPLegend*,QCPAbstractLegendItem*)));
   connect(ui->FieldsTW, SIGNAL(itemSelectionChanged()), this, SLOT(plotLogs()));
-  connect(ui->logTable, SIGNAL(itemSelectionChanged()), this, SLOT(plotLogs()));
+  connect(ui->logTable->selectionModel(), SIGNAL(selectionChanged(QItemSelection, QItemSelection)), this, SLOT(plotLogs()));
   connect(ui->Reset_PB, SIGNAL(clicked()), this, SLOT(plotLogs()));
   connect(ui->SaveSession_PB, SIGNAL(clicked()), this, SLOT(saveSession()));
 }
@@ -236,18 +241,44 @@ void LogsDialog::selectionChanged()
   }
 }
 
-QList<QStringList> LogsDialog::filterGePoints(const QList<QStringList> & input)
+QVector<QPair<int, int> > LogsDialog::selectedRows() const
+{
+  // merged [first, last) row ranges of the table selection, the whole log when nothing is selected
+  QVector<QPair<int, int> > ranges;
+  foreach (const QItemSelectionRange & range, ui->logTable->selectionModel()->selection()) {
+    ranges.append(qMakePair(range.top(), range.bottom() + 1));
+  }
+  std::sort(ranges.begin(), ranges.end());
+
+  QVector<QPair<int, int> > result;
+  for (int i = 0; i < ranges.size(); i++) {
+    if (!result.isEmpty() && ranges.at(i).first <= result.last().second) {
+      result.last().second = qMax(result.last().second, ranges.at(i).second);
+    }
+    else {
+      result.append(ranges.at(i));
+    }
+  }
+
+  if (result.isEmpty() && !logIndex.isEmpty()) {
+    result.append(qMakePair(0, logIndex.rowCount()));
+  }
+
+  return result;
+}
+
+QList<QStringList> LogsDialog::filterGePoints()
 {
   QList<QStringList> result;
 
-  int n = input.count();
-  if (n == 0) {
+  if (logIndex.isEmpty()) {
     return result;
   }
 
+  const QStringList & columns = logIndex.columns();
   int gpscol = 0;
-  for (int i=1; i<input.at(0).count(); i++) {
-    if (input.at(0).at(i) == "GPS") {
+  for (int i=1; i<columns.count(); i++) {
+    if (columns.at(i) == "GPS") {
       gpscol=i;
     }
   }
@@ -258,16 +289,15 @@ The columns for altitude \"GAlt\" and for speed \"GSpd\" are optional"));
     return result;
   }
 
-  result.append(input.at(0));
-  bool rangeSelected = ui->logTable->selectionModel()->selectedRows().length() > 0;
+  result.append(columns);
 
   GpsGlitchFilter glitchFilter;
   GpsLatLonFilter latLonFilter;
 
-  for (int i = 1; i < n; i++) {
-    if ((ui->logTable->item(i-1, 1)->isSelected() && rangeSelected) || !rangeSelected) {
-
-      GpsCoord coord = extractGpsCoordinates(input.at(i).at(gpscol));
+  QVector<QPair<int, int> > rows = selectedRows();
+  for (int r = 0; r < rows.size(); r++) {
+    for (int i = rows.at(r).first; i < rows.at(r).second; i++) {
+      GpsCoord coord = extractGpsCoordinates(logIndex.field(i, gpscol));
 
       // glitch filter
       if ( glitchFilter.isGlitch(coord) ) {
@@ -282,18 +312,18 @@ The columns for altitude \"GAlt\" and for speed \"GSpd\" are optional"));
       }
 
       // qDebug() << "point " << latitude << longitude;
-      result.append(input.at(i));
+      result.append(logIndex.row(i));
     }
   }
 
-  // qDebug() << "filterGePoints(): filtered from" << input.count() << "to " << result.count() << "points";
+  // qDebug() << "filterGePoints(): filtered from" << logIndex.rowCount() << "to " << result.count() << "points";
   return result;
 }
 
 void LogsDialog::exportToGoogleEarth()
 {
   // filter data points
-  QList<QStringList> dataPoints = filterGePoints(csvlog);
+  QList<QStringList> dataPoints = filterGePoints();
   int n = dataPoints.count(); // number of points to export
   if (n==0) return;
 
@@ -572,37 +602,26 @@ void LogsDialog::on_fileOpen_BT_clicked()
     g.logDir(fileName);
     ui->FileName_LE->setText(fileName);
     if (cvsFileParse()) {
+      const QStringList & columns = logIndex.columns();
       ui->FieldsTW->clear();
-      ui->logTable->clear();
       ui->FieldsTW->setShowGrid(false);
       ui->FieldsTW->setContentsMargins(0,0,0,0);
-      ui->FieldsTW->setRowCount(csvlog.at(0).count()-2);
+      ui->FieldsTW->setRowCount(columns.count()-2);
       ui->FieldsTW->setColumnCount(1);
       ui->FieldsTW->setHorizontalHeaderLabels(QStringList(tr("Available fields")));
-      ui->logTable->setSelectionBehavior(QAbstractItemView::SelectRows);
-      for (int i=2; i<csvlog.at(0).count(); i++) {
-        QTableWidgetItem* item= new QTableWidgetItem(csvlog.at(0).at(i));
+      for (int i=2; i<columns.count(); i++) {
+        QTableWidgetItem* item= new QTableWidgetItem(columns.at(i));
         ui->FieldsTW->setItem(i-2, 0, item);
       }
       ui->FieldsTW->resizeRowsToContents();
-      ui->logTable->setColumnCount(csvlog.at(0).count());
-      ui->logTable->setRowCount(csvlog.count()-1);
-      ui->logTable->setHorizontalHeaderLabels(csvlog.at(0));
-
-      QAbstractItemModel *model = ui->logTable->model();
-      for (int i=1; i<csvlog.count(); i++) {
-        for (int j=0; j<csvlog.at(0).count(); j++) {
-          model->setData(model->index(i - 1, j, QModelIndex()), csvlog.at(i).at(j));
-        }
-      }
 
       ui->logTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
       QVarLengthArray<int> sizes;
-      for (int i = 0; i < ui->logTable->columnCount(); i++) {
+      for (int i = 0; i < logModel->columnCount(); i++) {
         sizes.append(ui->logTable->columnWidth(i));
       }
       ui->logTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
-      for (int i = 0; i < ui->logTable->columnCount(); i++) {
+      for (int i = 0; i < logModel->columnCount(); i++) {
         ui->logTable->setColumnWidth(i, sizes.at(i));
       }
     }
@@ -614,92 +633,48 @@ void LogsDialog::saveSession()
   int index = ui->sessions_CB->currentIndex();
   // ignore index 0 is its all sessions combined
   if(index > 0) {
-    int n = csvlog.count();
-    QList<QStringList> sessionCsvLog;
-    // add CSV headers from first row of source file
-    sessionCsvLog.push_back(csvlog[0]);
-    // find session breaks
-    int currentSession = 0;
-    QDateTime lastvalue;
-    for (int i = 1; i < n; i++) {
-      QDateTime tmp = getRecordTimeStamp(i);
-      if (!lastvalue.isValid() || lastvalue.secsTo(tmp) > 60) {
-        currentSession++;
-      }
-      lastvalue = tmp;
-      if(currentSession == index) {
-        // add records to filtered list
-        sessionCsvLog.push_back(csvlog[i]);
-      }
-      else if (currentSession > index) {
-        break;
-      }
+    int first = ui->sessions_CB->itemData(index, Qt::UserRole).toInt();
+    int last;
+    if (index < ui->sessions_CB->count() - 1) {
+      last = ui->sessions_CB->itemData(index + 1, Qt::UserRole).toInt();
     }
-    // save the filtered records to a new file
+    else {
+      last = logIndex.rowCount();
+    }
+    // save the session records, with the CSV headers of the source file, to a new file
     QString newFilename = logFilename;
     newFilename.append(QString("-Session%1.csv").arg(index));
     QString filename = QFileDialog::getSaveFileName(this, "Save log", newFilename, "CSV files (.csv);", 0, 0); // getting the filename (full path)
     QFile data(filename);
     if(data.open(QFile::WriteOnly |QFile::Truncate)) {
-      QTextStream output(&data);
-      int numRecords = sessionCsvLog.count();
-      for(int i = 0; i < numRecords; i++){
-        output << sessionCsvLog[i].join(",") << '\n';
+      data.write(logIndex.rawHeader() + '\n');
+      for(int i = first; i < last; i++){
+        data.write(logIndex.rawRow(i) + '\n');
       }
     }
-    sessionCsvLog.clear();
   }
 }
 
 bool LogsDialog::cvsFileParse()
 {
-  QFile file(ui->FileName_LE->text());
-  int errors=0;
-  int lines=-1;
+  logFilename.clear();
 
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) { // reading HEX TEXT file
+  // the file is mapped and indexed, rows are read from it when needed
+  bool opened = logIndex.open(ui->FileName_LE->text());
+  logModel->reload();
+  if (!opened) {
     return false;
   }
-  else {
-    csvlog.clear();
-    logFilename.clear();
-    QTextStream inputStream(&file);
-    QString buffer = file.readLine();
-
-    if (buffer.startsWith("Date,Time")) {
-      file.reset();
-    }
-    else {
-      return false;
-    }
-
-    int numfields=-1;
-    while (!file.atEnd()) {
-      QString line = file.readLine().trimmed();
-      QStringList columns = line.split(',');
-      if (numfields==-1) {
-        numfields=columns.count();
-      }
-      if (columns.count()==numfields) {
-        csvlog.append(columns);
-      }
-      else {
-        errors++;
-      }
-      lines++;
-    }
 
-    logFilename = QFileInfo(file.fileName()).baseName();
-  }
+  logFilename = QFileInfo(ui->FileName_LE->text()).baseName();
 
-  file.close();
-  if (errors > 1) {
-    QMessageBox::warning(this, CPN_STR_APP_NAME, tr("The selected logfile contains %1 invalid lines out of  %2 total lines").arg(errors).arg(lines));
+  if (logIndex.invalidLineCount() > 1) {
+    QMessageBox::warning(this, CPN_STR_APP_NAME, tr("The selected logfile contains %1 invalid lines out of  %2 total lines").arg(logIndex.invalidLineCount()).arg(logIndex.lineCount()));
   }
 
-  int n = csvlog.count();
-  if (n == 1) {
-    csvlog.clear();
+  if (logIndex.isEmpty()) {
+    logIndex.close();
+    logModel->reload();
     return false;
   }
 
@@ -717,10 +692,7 @@ struct FlightSession {
 
 QDateTime LogsDialog::getRecordTimeStamp(int index)
 {
-  QString tstamp = csvlog.at(index).at(0) + " " + csvlog.at(index).at(1);
-  if (csvlog.at(index).at(1).contains("."))
-    return QDateTime::fromString(tstamp, "yyyy-MM-dd HH:mm:ss.zzz");
-  return QDateTime::fromString(tstamp, "yyyy-MM-dd HH:mm:ss");
+  return QDateTime::fromMSecsSinceEpoch(qRound64(logIndex.timestamp(index) * 1000));
 }
 
 QString LogsDialog::generateDuration(const QDateTime & start, const QDateTime & end)
@@ -740,35 +712,32 @@ void LogsDialog::setFlightSessions()
   ui->sessions_CB->clear();
   ui->SaveSession_PB->setEnabled(false);
 
-  int n = csvlog.count();
+  int n = logIndex.rowCount();
   // qDebug() << "records" << n;
 
   // find session breaks
   QList<int> sessions;
-  QDateTime lastvalue;
-  for (int i = 1; i < n; i++) {
-    QDateTime tmp = getRecordTimeStamp(i);
-    if (!lastvalue.isValid() || lastvalue.secsTo(tmp) > 60) {
-      sessions.push_back(i-1);
-      // qDebug() << "session index" << i-1;
+  for (int i = 0; i < n; i++) {
+    if (i == 0 || logIndex.timestamp(i) - logIndex.timestamp(i - 1) > 60) {
+      sessions.push_back(i);
+      // qDebug() << "session index" << i;
     }
-    lastvalue = tmp;
   }
-  sessions.push_back(n-1);
+  sessions.push_back(n);
 
   //now construct a list of sessions with their times
   //total time
   int noSesions = sessions.size()-1;
   QString label = QString("%1 ").arg(noSesions);
   label += tr(noSesions > 1 ? "sessions" : "session");
-  label += " <" + tr("time span") + generateDuration(getRecordTimeStamp(1), getRecordTimeStamp(n-1)) + ">";
+  label += " <" + tr("time span") + generateDuration(getRecordTimeStamp(0), getRecordTimeStamp(n-1)) + ">";
   ui->sessions_CB->addItem(label);
 
   // add individual sessions
   if (sessions.size() > 2) {
     for (int i = 1; i < sessions.size(); i++) {
-      QDateTime sessionStart = getRecordTimeStamp(sessions.at(i-1)+1);
-      QDateTime sessionEnd = getRecordTimeStamp(sessions.at(i));
+      QDateTime sessionStart = getRecordTimeStamp(sessions.at(i-1));
+      QDateTime sessionEnd = getRecordTimeStamp(sessions.at(i)-1);
       QString label = sessionStart.toString("HH:mm:ss") + " <" + tr("duration ") + generateDuration(sessionStart, sessionEnd) + ">";
       ui->sessions_CB->addItem(label, sessions.at(i-1));
       // qDebug() << "added label" << label << sessions.at(i-1);
@@ -788,13 +757,13 @@ void LogsDialog::on_sessions_CB_currentIndexChanged(int index)
     if (index < ui->sessions_CB->count() - 1) {
       bottom = ui->sessions_CB->itemData(index + 1, Qt::UserRole).toInt();
     } else {
-      bottom = ui->logTable->rowCount();
+      bottom = logModel->rowCount();
     }
 
-    QModelIndex topLeft = ui->logTable->model()->index(
+    QModelIndex topLeft = logModel->index(
       ui->sessions_CB->itemData(index, Qt::UserRole).toInt(), 0 , QModelIndex());
-    QModelIndex bottomRight = ui->logTable->model()->index(
-      bottom - 1, ui->logTable->columnCount() - 1, QModelIndex());
+    QModelIndex bottomRight = logModel->index(
+      bottom - 1, logModel->columnCount() - 1, QModelIndex());
 
     QItemSelection selection(topLeft, bottomRight);
     ui->logTable->selectionModel()->select(selection, QItemSelectionModel::Select);
@@ -813,75 +782,41 @@ void LogsDialog::plotLogs()
 {
   if (plotLock) return;
 
-  if (!ui->FieldsTW->selectedItems().length()) {
+  if (logIndex.isEmpty() || !ui->FieldsTW->selectedItems().length()) {
     removeAllGraphs();
     return;
   }
 
-  plotsCollection plots;
-
-  QModelIndexList selection = ui->logTable->selectionModel()->selectedRows();
-  int rowCount = selection.length();
-  bool hasLogSelection;
-  QVarLengthArray<int> selectedRows;
-
-  if (rowCount) {
-    hasLogSelection = true;
-    foreach (QModelIndex index, selection) {
-      selectedRows.append(index.row());
-    }
-    std::sort(selectedRows.begin(), selectedRows.end());
-  } else {
-    hasLogSelection = false;
-    rowCount = ui->logTable->rowCount();
-  }
+  plots.coords.clear();
+  plotRows = selectedRows();
 
   plots.min_x = QDateTime::currentDateTime().toTime_t();
   plots.max_x = 0;
+  for (int r = 0; r < plotRows.size(); r++) {
+    double first = logIndex.timestamp(plotRows.at(r).first);
+    double last = logIndex.timestamp(plotRows.at(r).second - 1);
+    if (plots.min_x > first) plots.min_x = first;
+    if (plots.max_x < last) plots.max_x = last;
+  }
 
   foreach (QTableWidgetItem *plot, ui->FieldsTW->selectedItems()) {
     coords_t plotCoords;
-    int plotColumn = plot->row() + 2; // Date and Time first
 
     plotCoords.min_y = INVALID_MIN;
     plotCoords.max_y = INVALID_MAX;
     plotCoords.yaxis = firstLeft;
     plotCoords.name = plot->text();
-
-    for (int row = 0; row < rowCount; row++) {
-      QTableWidgetItem *logValue;
-      double y;
-      double time;
-      QString time_str;
-
-      if (hasLogSelection) {
-        logValue = ui->logTable->item(selectedRows.at(row), plotColumn);
-        time_str = ui->logTable->item(selectedRows.at(row), 0)->text() +
-          QString(" ") + ui->logTable->item(selectedRows.at(row), 1)->text();
-      } else {
-        logValue = ui->logTable->item(row, plotColumn);
-        time_str = ui->logTable->item(row, 0)->text() + QString(" ") +
-          ui->logTable->item(row, 1)->text();
-      }
-
-      y = logValue->text().toDouble();
-      plotCoords.y.push_back(y);
-
-      if (plotCoords.min_y > y) plotCoords.min_y = y;
-      if (plotCoords.max_y < y) plotCoords.max_y = y;
-
-      if (time_str.contains('.')) {
-        time = QDateTime::fromString(time_str, "yyyy-MM-dd HH:mm:ss.zzz")
-          .toTime_t();
-        time += time_str.mid(time_str.indexOf('.')).toDouble();
-      } else {
-        time = QDateTime::fromString(time_str, "yyyy-MM-dd HH:mm:ss")
-          .toTime_t();
+    plotCoords.column = plot->row() + 2; // Date and Time first
+    plotCoords.scale = 1;
+    plotCoords.offset = 0;
+
+    // the ranges come from the index, the points are sampled once the axes are set
+    for (int r = 0; r < plotRows.size(); r++) {
+      double min, max;
+      if (logIndex.minMax(plotCoords.column, plotRows.at(r).first, plotRows.at(r).second, min, max)) {
+        if (plotCoords.min_y > min) plotCoords.min_y = min;
+        if (plotCoords.max_y < max) plotCoords.max_y = max;
       }
-      plotCoords.x.push_back(time);
-
-      if (plots.min_x > time) plots.min_x = time;
-      if (plots.max_x < time) plots.max_x = time;
     }
 
     double range_inc = (plotCoords.max_y - plotCoords.min_y) / 100;
@@ -956,11 +891,8 @@ void LogsDialog::plotLogs()
 
     for (int i = 0; i < plots.coords.size(); i++) {
       plots.coords[i].yaxis = firstLeft;
-
-      double factor = 100 / (plots.coords.at(i).max_y - plots.coords.at(i).min_y);
-      for (int j = 0; j < plots.coords.at(i).y.count(); j++) {
-        plots.coords[i].y[j] = factor * (plots.coords.at(i).y.at(j) - plots.coords.at(i).min_y);
-      }
+      plots.coords[i].scale = 100 / (plots.coords.at(i).max_y - plots.coords.at(i).min_y);
+      plots.coords[i].offset = plots.coords.at(i).min_y;
     }
   } else {
     for (int i = firstRight; i < AXES_LIMIT; i++) {
@@ -984,6 +916,8 @@ void LogsDialog::plotLogs()
     axisRect->axis(QCPAxis::atLeft)->setTickLabels(true);
   }
 
+  samplePlots();
+
   if (yAxesRanges[firstRight].max != INVALID_MAX) {
     axisRect->axis(QCPAxis::atRight)->setRange(yAxesRanges[firstRight].min,
       yAxesRanges[firstRight].max);
@@ -1066,6 +1000,51 @@ void LogsDialog::plotLogs()
   ui->customPlot->replot();
 }
 
+void LogsDialog::samplePlots()
+{
+  // only the visible part of the selected rows is sampled, at about one bucket per pixel
+  QCPRange range = axisRect->axis(QCPAxis::atBottom)->range();
+  int width = qMax(axisRect->width(), 1);
+
+  for (int i = 0; i < plots.coords.size(); i++) {
+    coords_t & coords = plots.coords[i];
+    coords.x.clear();
+    coords.y.clear();
+
+    for (int r = 0; r < plotRows.size(); r++) {
+      // one row past each border keeps the lines going to the edges of the plot
+      int first = qMax(plotRows.at(r).first, logIndex.rowAt(range.lower) - 1);
+      int last = qMin(plotRows.at(r).second, logIndex.rowAt(range.upper) + 1);
+      if (first >= last) {
+        continue;
+      }
+      double span = logIndex.timestamp(last - 1) - logIndex.timestamp(first);
+      int buckets = range.size() > 0 ? qBound(1, int(width * span / range.size()), width) : width;
+      logIndex.sample(coords.column, first, last, buckets, coords.x, coords.y);
+    }
+
+    if (coords.scale != 1) {
+      for (int j = 0; j < coords.y.count(); j++) {
+        coords.y[j] = coords.scale * (coords.y.at(j) - coords.offset);
+      }
+    }
+
+    if (i < ui->customPlot->graphCount()) {
+      ui->customPlot->graph(i)->setData(coords.x, coords.y);
+    }
+  }
+}
+
+void LogsDialog::xAxisChangeRange(QCPRange range)
+{
+  Q_UNUSED(range);
+
+  // graphs are only all there at the end of plotLogs()
+  if (ui->customPlot->graphCount() == plots.coords.size()) {
+    samplePlots();
+  }
+}
+
 void LogsDialog::yAxisChangeRanges(QCPRange range)
 {
   if (axisRect->axis(QCPAxis::atRight)->visible()) {
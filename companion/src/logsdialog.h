@@ -24,6 +24,7 @@
 #include <QtCore>
 #include <QDialog>
 #include "qcustomplot.h"
+#include "logindex.h"
 
 #define INVALID_MIN 999999
 #define INVALID_MAX -999999
@@ -50,6 +51,9 @@ class LogsDialog : public QDialog
     double max_y;
     yaxes_t yaxis;
     QString name;
+    int column;
+    double scale;   // applied to y - offset when all plots share the left axis
+    double offset;
   };
 
   struct minMax_t {
@@ -82,9 +86,13 @@ private slots:
   void on_sessions_CB_currentIndexChanged(int index);
   void on_mapsButton_clicked();
   void yAxisChangeRanges(QCPRange range);
+  void xAxisChangeRange(QCPRange range);
 
 private:
-  QList<QStringList> csvlog;
+  LogIndex logIndex;
+  LogTableModel * logModel;
+  plotsCollection plots;
+  QVector<QPair<int, int> > plotRows;
   Ui::LogsDialog *ui;
   QCPAxisRect *axisRect;
   QCPLegend *rightLegend;
@@ -103,7 +111,9 @@ private:
   QCPItemStraightLine * cursorLine;
 
   bool cvsFileParse();
-  QList<QStringList> filterGePoints(const QList<QStringList> & input);
+  QVector<QPair<int, int> > selectedRows() const;
+  void samplePlots();
+  QList<QStringList> filterGePoints();
   void exportToGoogleEarth();
   QDateTime getRecordTimeStamp(int index);
   QString generateDuration(const QDateTime & start, const QDateTime & end);
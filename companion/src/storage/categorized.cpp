@@ -42,6 +42,15 @@ bool CategorizedStorageFormat::load(RadioData & radioData)
     return false;
   }
 
+  struct ModelFile {
+    int index;
+    int category;
+    QString fileName;
+    QByteArray buffer;
+    bool loaded;
+  };
+  QList<ModelFile> modelFiles;
+
   QList<QByteArray> lines = modelsListBuffer.split('\n');
   int modelIndex = 0;
   int categoryIndex = -1;
@@ -80,27 +89,15 @@ bool CategorizedStorageFormat::load(RadioData & radioData)
       // parse model file name and load
       QString fileName = parts[0];
       qDebug() << "Loading model from file" << fileName << "into slot" << modelIndex;
-      QByteArray modelBuffer;
-      if (!loadFile(modelBuffer, QString("MODELS/%1").arg(fileName))) {
+      ModelFile modelFile = { modelIndex, categoryIndex, fileName, QByteArray(), false };
+      if (!loadFile(modelFile.buffer, QString("MODELS/%1").arg(fileName))) {
         setError(tr("Can't extract %1").arg(fileName));
         return false;
       }
       if ((int)radioData.models.size() <= modelIndex) {
         radioData.models.resize(modelIndex + 1);
       }
-      if (!loadModelFromByteArray(radioData.models[modelIndex], modelBuffer)) {
-        setError(tr("Error loading models"));
-        return false;
-      }
-      strncpy(radioData.models[modelIndex].filename, qPrintable(fileName), sizeof(radioData.models[modelIndex].filename));
-      if (IS_FAMILY_HORUS_OR_T16(board) && !strcmp(radioData.generalSettings.currModelFilename, qPrintable(fileName))) {
-        radioData.generalSettings.currModelIndex = modelIndex;
-        qDebug() << "currModelIndex =" << modelIndex;
-      }
-      if (getCurrentFirmware()->getCapability(HasModelCategories)) {
-        radioData.models[modelIndex].category = categoryIndex;
-      }
-      radioData.models[modelIndex].used = true;
+      modelFiles.append(modelFile);
       modelIndex++;
       continue;
     }
@@ -110,6 +107,34 @@ bool CategorizedStorageFormat::load(RadioData & radioData)
     qDebug() << "Invalid line" <<line;
     continue;
   }
+
+  // models are independent from each other, they are decoded concurrently
+  QList<std::function<void()>> jobs;
+  for (ModelFile & modelFile: modelFiles) {
+    ModelData * model = &radioData.models[modelFile.index];
+    jobs.append([model, &modelFile]() {
+      modelFile.loaded = (loadModelFromByteArray(*model, modelFile.buffer) != nullptr);
+    });
+  }
+  runInParallel(jobs);
+
+  foreach (const ModelFile & modelFile, modelFiles) {
+    if (!modelFile.loaded) {
+      setError(tr("Error loading models"));
+      return false;
+    }
+    ModelData & model = radioData.models[modelFile.index];
+    strncpy(model.filename, qPrintable(modelFile.fileName), sizeof(model.filename));
+    if (IS_FAMILY_HORUS_OR_T16(board) && !strcmp(radioData.generalSettings.currModelFilename, qPrintable(modelFile.fileName))) {
+      radioData.generalSettings.currModelIndex = modelFile.index;
+      qDebug() << "currModelIndex =" << modelFile.index;
+    }
+    if (getCurrentFirmware()->getCapability(HasModelCategories)) {
+      model.category = modelFile.category;
+    }
+    model.used = true;
+  }
+
   return true;
 }
 
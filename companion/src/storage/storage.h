@@ -26,6 +26,8 @@
 #include <QtCore>
 #include <QString>
 #include <QDebug>
+#include <QThreadPool>
+#include <functional>
 
 enum StorageType
 {
@@ -160,6 +162,34 @@ class Storage : public StorageFormat
 void registerStorageFactories();
 void unregisterStorageFactories();
 
+class StorageJob : public QRunnable
+{
+  public:
+    explicit StorageJob(const std::function<void()> & function):
+      function(function)
+    {
+    }
+
+    void run() override
+    {
+      function();
+    }
+
+  protected:
+    std::function<void()> function;
+};
+
+// Runs independent jobs (e.g. the decoding of each model) on all the CPU
+// cores, returns when all of them are done
+inline void runInParallel(const QList<std::function<void()>> & jobs)
+{
+  QThreadPool pool;
+  foreach (const std::function<void()> & job, jobs) {
+    pool.start(new StorageJob(job));
+  }
+  pool.waitForDone();
+}
+
 #if 0
 unsigned long LoadBackup(RadioData &radioData, uint8_t *eeprom, int esize, int index);
 unsigned long LoadEeprom(RadioData &radioData, const uint8_t *eeprom, int size);
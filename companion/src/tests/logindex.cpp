@@ -0,0 +1,89 @@
+#include "gtests.h"
+#include "logindex.h"
+
+static void writeLog(QTemporaryFile & file, int rows)
+{
+  ASSERT_TRUE(file.open());
+  QTextStream stream(&file);
+  stream << "Date,Time,RSSI,Alt(m),GPS\n";
+  QTime time(12, 0);
+  for (int i = 0; i < rows; i++) {
+    if (i == rows / 2) {
+      // second flight session, 5 minutes later
+      time = time.addSecs(300);
+      stream << "invalid line\n";
+    }
+    stream << "2020-05-14," << time.toString("HH:mm:ss.zzz") << "," << (i % 100) << "," << (i * 7 % 1001) - 500 << ".5,45.1 7.6\n";
+    time = time.addMSecs(100);
+  }
+  stream.flush();
+  file.close();
+}
+
+TEST(LogIndex, parseValue)
+{
+  EXPECT_EQ(0, LogIndex::parseValue("0", 1));
+  EXPECT_EQ(-12.5, LogIndex::parseValue("-12.5", 5));
+  EXPECT_EQ(42, LogIndex::parseValue(" 42 ", 4));
+  EXPECT_EQ(1500, LogIndex::parseValue("1.5e3", 5));
+  EXPECT_EQ(0, LogIndex::parseValue("45.1 7.6", 8));
+  EXPECT_EQ(0, LogIndex::parseValue("", 0));
+}
+
+TEST(LogIndex, rowsAndSessions)
+{
+  QTemporaryFile file;
+  writeLog(file, 1000);
+
+  LogIndex index;
+  ASSERT_TRUE(index.open(file.fileName()));
+  EXPECT_EQ(1000, index.rowCount());
+  EXPECT_EQ(5, index.columnCount());
+  EXPECT_EQ(1001, index.lineCount());
+  EXPECT_EQ(1, index.invalidLineCount());
+  EXPECT_EQ(QString("Alt(m)"), index.columns().at(3));
+  EXPECT_EQ(QByteArray("Date,Time,RSSI,Alt(m),GPS"), index.rawHeader());
+  EXPECT_EQ(QString("45.1 7.6"), index.field(10, 4));
+  EXPECT_EQ(QStringList() << "2020-05-14" << "12:00:01.000" << "10" << "-430.5" << "45.1 7.6", index.row(10));
+
+  EXPECT_NEAR(0.1, index.timestamp(1) - index.timestamp(0), 0.0001);
+  EXPECT_NEAR(300.1, index.timestamp(500) - index.timestamp(499), 0.0001);
+  EXPECT_EQ(500, index.rowAt(index.timestamp(499) + 1));
+}
+
+TEST(LogIndex, minMaxAndSample)
+{
+  QTemporaryFile file;
+  writeLog(file, 100000);
+
+  LogIndex index;
+  ASSERT_TRUE(index.open(file.fileName()));
+
+  const int ranges[][2] = { {0, 100000}, {0, 1}, {63, 65}, {1000, 31000}, {12345, 67890} };
+  for (unsigned i = 0; i < sizeof(ranges) / sizeof(ranges[0]); i++) {
+    double expectedMin = 1e9, expectedMax = -1e9;
+    for (int row = ranges[i][0]; row < ranges[i][1]; row++) {
+      expectedMin = std::min(expectedMin, index.value(row, 3));
+      expectedMax = std::max(expectedMax, index.value(row, 3));
+    }
+    double min, max;
+    ASSERT_TRUE(index.minMax(3, ranges[i][0], ranges[i][1], min, max));
+    EXPECT_EQ(expectedMin, min);
+    EXPECT_EQ(expectedMax, max);
+  }
+
+  QVector<double> x, y;
+  index.sample(3, 0, 100000, 500, x, y);
+  EXPECT_GE(1000, x.size());
+  EXPECT_EQ(x.size(), y.size());
+  EXPECT_EQ(-500.5, *std::min_element(y.begin(), y.end()));
+  EXPECT_EQ(500.5, *std::max_element(y.begin(), y.end()));
+  EXPECT_TRUE(std::is_sorted(x.begin(), x.end()));
+
+  x.clear();
+  y.clear();
+  index.sample(2, 100, 150, 500, x, y);
+  EXPECT_EQ(50, x.size());
+  EXPECT_EQ(index.timestamp(100), x.first());
+  EXPECT_EQ(49, y.last());
+}
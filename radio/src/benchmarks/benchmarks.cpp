@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+/*
+  Microbenchmarks of the radio hot paths, run on the host with the simu target.
+
+  Build and run them with the "benchmarks" target: the results are written to
+  benchmarks-radio.json, which Google Benchmark's tools/compare.py compares to
+  the results of another commit. Any Google Benchmark option can be given when
+  running benchmarks-radio directly, e.g. --benchmark_filter=Mixer
+*/
+
+#include "benchmarks.h"
+
+uint16_t anaInValues[NUM_STICKS+NUM_POTS+NUM_SLIDERS] = { 0 };
+uint16_t anaIn(uint8_t chan)
+{
+  if (chan < NUM_STICKS+NUM_POTS+NUM_SLIDERS)
+    return anaInValues[chan];
+  else
+    return 0;
+}
+
+uint16_t getAnalogValue(uint8_t index)
+{
+  return anaIn(index);
+}
+
+static void setupBenchmarkCurves()
+{
+  // curve 1: 5 points, curve 2: 9 points smooth,
+  // curve 3: 17 points custom smooth, curve 4: 17 points
+  g_model.curves[0].points = 0;
+  g_model.curves[1].points = 4;
+  g_model.curves[1].smooth = 1;
+  g_model.curves[2].type = CURVE_TYPE_CUSTOM;
+  g_model.curves[2].points = 12;
+  g_model.curves[2].smooth = 1;
+  g_model.curves[3].points = 12;
+
+  int8_t * points = g_model.points;
+  for (int i = 0; i < 5; i++) {
+    *points++ = (i - 2) * (i - 2) * (i - 2) * 25 / 2;
+  }
+  for (int i = 0; i < 9; i++) {
+    *points++ = (i - 4) * 25;
+  }
+  for (int i = 0; i < 17; i++) {
+    *points++ = (i * i * 100 / 256) * 2 - 100;
+  }
+  for (int i = 1; i < 16; i++) {
+    *points++ = i * 12 - 100 + (i % 3);
+  }
+  for (int i = 0; i < 17; i++) {
+    *points++ = (i % 2) ? 50 : -50;
+  }
+
+  loadCurves();
+  invalidateCurveTangents();
+}
+
+static void setupBenchmarkInputs()
+{
+  // the 4 default inputs get some expo, 4 more inputs go through the curves
+  for (int i = 0; i < NUM_STICKS; i++) {
+    expoAddress(i)->curve.value = 30;
+  }
+  for (int i = 0; i < 4; i++) {
+    ExpoData * expo = expoAddress(NUM_STICKS + i);
+    expo->srcRaw = MIXSRC_Rud + i;
+    expo->chn = NUM_STICKS + i;
+    expo->weight = 100;
+    expo->mode = 3;
+    expo->curve.type = CURVE_REF_CUSTOM;
+    expo->curve.value = i + 1;
+  }
+}
+
+static void setupBenchmarkMixes()
+{
+  // 2 mixes on each of the 16 first channels
+  for (int i = 0; i < 32; i++) {
+    MixData * mix = mixAddress(i);
+    int ch = i / 2;
+    mix->destCh = ch;
+    mix->weight = 100 - i;
+    mix->offset = i * 2 - 32;
+    if (i % 2 == 0) {
+      mix->srcRaw = MIXSRC_FIRST_INPUT + (ch % (NUM_STICKS + 4));
+    }
+    else {
+      mix->srcRaw = (ch > 0 && ch % 3 == 0) ? MIXSRC_FIRST_CH + ch - 1 : MIXSRC_MAX;
+      mix->swtch = SWSRC_FIRST_LOGICAL_SWITCH + (i % 16);
+      mix->mltpx = (ch % 3 == 1) ? MLTPX_MUL : MLTPX_ADD;
+    }
+    switch (i % 4) {
+      case 1:
+        mix->curve.type = CURVE_REF_DIFF;
+        mix->curve.value = 20;
+        break;
+      case 2:
+        mix->curve.type = CURVE_REF_CUSTOM;
+        mix->curve.value = (i / 4) % 4 + 1;
+        break;
+      case 3:
+        mix->curve.type = CURVE_REF_EXPO;
+        mix->curve.value = 40;
+        break;
+    }
+  }
+  // the last channel is slowed down
+  mixAddress(30)->speedUp = 10;
+  mixAddress(30)->speedDown = 10;
+}
+
+static void setupBenchmarkLogicalSwitches()
+{
+  for (int i = 0; i < 32; i++) {
+    LogicalSwitchData * ls = lswAddress(i);
+    switch (i % 8) {
+      case 0:
+        ls->func = LS_FUNC_VPOS;
+        ls->v1 = MIXSRC_FIRST_INPUT + (i / 8);
+        ls->v2 = i * 2;
+        break;
+      case 1:
+        ls->func = LS_FUNC_VNEG;
+        ls->v1 = MIXSRC_FIRST_CH + (i % 16);
+        ls->v2 = -i;
+        break;
+      case 2:
+        ls->func = LS_FUNC_APOS;
+        ls->v1 = MIXSRC_Rud + (i / 8);
+        ls->v2 = 50;
+        break;
+      case 3:
+        ls->func = LS_FUNC_GREATER;
+        ls->v1 = MIXSRC_FIRST_INPUT + (i / 8);
+        ls->v2 = MIXSRC_FIRST_CH + (i / 8);
+        break;
+      case 4:
+        ls->func = LS_FUNC_AND;
+        ls->v1 = SWSRC_FIRST_LOGICAL_SWITCH + i - 4;
+        ls->v2 = SWSRC_SA0;
+        break;
+      case 5:
+        ls->func = LS_FUNC_OR;
+        ls->v1 = SWSRC_FIRST_LOGICAL_SWITCH + i - 5;
+        ls->v2 = SWSRC_FIRST_LOGICAL_SWITCH + i - 4;
+        break;
+      case 6:
+        ls->func = LS_FUNC_DIFFEGREATER;
+        ls->v1 = MIXSRC_FIRST_CH + (i / 8);
+        ls->v2 = 10;
+        break;
+      case 7:
+        ls->func = LS_FUNC_TIMER;
+        ls->v1 = 5;
+        ls->v2 = 5;
+        break;
+    }
+    if (i % 3 == 0) {
+      ls->andsw = SWSRC_SA0;
+    }
+  }
+}
+
+void setupBenchmarkModel()
+{
+#if defined(EEPROM)
+  memset(modelHeaders, 0, sizeof(modelHeaders));
+#endif
+  generalDefault();
+  g_eeGeneral.templateSetup = 0;
+#if defined(PCBFRSKY)
+  g_eeGeneral.switchConfig = 0x00007bff;
+#endif
+  for (int i = 0; i < NUM_SWITCHES; i++) {
+    simuSetSwitch(i, -1);
+  }
+
+  setModelDefaults(0);
+  setupBenchmarkCurves();
+  setupBenchmarkInputs();
+  setupBenchmarkMixes();
+  setupBenchmarkLogicalSwitches();
+
+  memset(anaInValues, 0, sizeof(anaInValues));
+  logicalSwitchesReset();
+  extern uint8_t s_mixer_first_run_done;
+  s_mixer_first_run_done = false;
+  lastFlightMode = 255;
+  evalMixes(1);
+}
+
+void moveSticks(uint32_t frame)
+{
+  // triangle waves of different periods, over the whole calibrated range
+  for (int i = 0; i < NUM_STICKS + NUM_POTS + NUM_SLIDERS; i++) {
+    int period = 2 * (64 + 16 * i);
+    int phase = frame % period;
+    int position = phase < period / 2 ? phase : period - phase;
+    anaInValues[i] = position * 2 * RESX / (period / 2);
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  simuInit();
+  startEepromThread(nullptr);
+#if defined(EEPROM_SIZE)
+  eeprom = (uint8_t *)malloc(EEPROM_SIZE);
+#endif
+#if !defined(COLORLCD)
+  menuLevel = 0;
+#endif
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+
+  return 0;
+}
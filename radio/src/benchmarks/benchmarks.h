@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _BENCHMARKS_H_
+#define _BENCHMARKS_H_
+
+#include <benchmark/benchmark.h>
+
+#define SWAP_DEFINED
+#include "opentx.h"
+#include "model_init.h"
+
+extern uint16_t anaInValues[NUM_STICKS+NUM_POTS+NUM_SLIDERS];
+
+// Radio defaults and a model using a good part of the mixer features:
+// inputs with curves, 32 mixes over 16 channels, 32 logical switches
+void setupBenchmarkModel();
+
+// Moves all sticks and pots, a different position for each frame
+void moveSticks(uint32_t frame);
+
+#endif // _BENCHMARKS_H_
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "benchmarks.h"
+
+#if defined(COLORLCD)
+
+#include "gui/colorlcd/fonts.h"
+
+static void Lcd_clear(benchmark::State & state)
+{
+  BitmapBuffer dc(BMP_RGB565, LCD_W, LCD_H);
+  for (auto _ : state) {
+    dc.clear(DEFAULT_BGCOLOR);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * LCD_W * LCD_H);
+}
+BENCHMARK(Lcd_clear);
+
+static void Lcd_drawFilledRect(benchmark::State & state)
+{
+  BitmapBuffer dc(BMP_RGB565, LCD_W, LCD_H);
+  uint8_t pattern = state.range(0) ? DOTTED : SOLID;
+  for (auto _ : state) {
+    dc.drawFilledRect(10, 10, 100, 100, pattern, TITLE_BGCOLOR);
+    benchmark::ClobberMemory();
+  }
+  state.SetLabel(state.range(0) ? "dotted" : "solid");
+  state.SetItemsProcessed(state.iterations() * 100 * 100);
+}
+BENCHMARK(Lcd_drawFilledRect)->Arg(0)->Arg(1);
+
+static void Lcd_drawRect(benchmark::State & state)
+{
+  BitmapBuffer dc(BMP_RGB565, LCD_W, LCD_H);
+  for (auto _ : state) {
+    dc.drawRect(10, 10, 200, 100, 2, SOLID, TITLE_BGCOLOR);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Lcd_drawRect);
+
+static void Lcd_drawLine(benchmark::State & state)
+{
+  BitmapBuffer dc(BMP_RGB565, LCD_W, LCD_H);
+  int x = 0;
+  for (auto _ : state) {
+    dc.drawLine(x, 0, LCD_W - 1 - x, LCD_H - 1, SOLID, DEFAULT_COLOR);
+    x = (x + 1) % LCD_W;
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Lcd_drawLine);
+
+static void Lcd_drawText(benchmark::State & state)
+{
+  static const LcdFlags sizes[] = { FONT(STD), FONT(XS), FONT(XL) };
+
+  loadFonts();
+  BitmapBuffer dc(BMP_RGB565, LCD_W, LCD_H);
+  LcdFlags flags = DEFAULT_COLOR | sizes[state.range(0)];
+  for (auto _ : state) {
+    dc.drawText(5, 5, "The quick brown fox jumps over the lazy dog", flags);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Lcd_drawText)->DenseRange(0, 2);
+
+#endif
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "benchmarks.h"
+#include "location.h"
+
+#if defined(LUA_MODEL_SCRIPTS)
+
+// A mix script doing what most of them do: some arithmetic on its inputs,
+// a table kept between runs, and a few allocations for the garbage collector
+static const char benchmarkScript[] =
+  "local inputs = { { 'In', SOURCE }, { 'Gain', VALUE, -100, 100, 50 } }\n"
+  "local outputs = { 'Avg', 'Max' }\n"
+  "local history = {}\n"
+  "local count = 0\n"
+  "local function run(input, gain)\n"
+  "  count = count + 1\n"
+  "  history[count % 32 + 1] = { value = input, time = getTime() }\n"
+  "  local sum, max = 0, -1024\n"
+  "  for i = 1, #history do\n"
+  "    local v = history[i].value\n"
+  "    sum = sum + v\n"
+  "    if v > max then max = v end\n"
+  "  end\n"
+  "  return sum * gain / (#history * 100), max\n"
+  "end\n"
+  "return { input = inputs, output = outputs, run = run }\n";
+
+static bool writeBenchmarkScript()
+{
+  simuFatfsSetPaths(BENCHMARKS_BUILD_PATH, BENCHMARKS_BUILD_PATH);
+  if (sdCheckAndCreateDirectory(SCRIPTS_PATH) || sdCheckAndCreateDirectory(SCRIPTS_MIXES_PATH)) {
+    return false;
+  }
+
+  FIL file;
+  UINT written;
+  if (f_open(&file, SCRIPTS_MIXES_PATH "/bench" SCRIPT_EXT, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK) {
+    return false;
+  }
+  bool result = f_write(&file, benchmarkScript, sizeof(benchmarkScript) - 1, &written) == FR_OK && written == sizeof(benchmarkScript) - 1;
+  f_close(&file);
+  return result;
+}
+
+static void Lua_luaTaskMixScripts(benchmark::State & state)
+{
+  int scripts = state.range(0);
+
+  setupBenchmarkModel();
+  if (!writeBenchmarkScript()) {
+    state.SkipWithError("cannot write the benchmark script");
+    return;
+  }
+  for (int i = 0; i < scripts; i++) {
+    ScriptData & sd = g_model.scriptsData[i];
+    strncpy(sd.file, "bench", LEN_SCRIPT_FILENAME);
+    sd.inputs[0].source = MIXSRC_Rud + (i % NUM_STICKS);
+    sd.inputs[1].value = 0;
+  }
+
+  // the first run loads the scripts
+  LUA_LOAD_MODEL_SCRIPTS();
+  luaTask(0, RUN_MIX_SCRIPT, false);
+  for (int i = 0; i < scripts; i++) {
+    if (scriptInternalData[i].state != SCRIPT_OK) {
+      state.SkipWithError("benchmark script not loaded");
+      return;
+    }
+  }
+
+  uint32_t frame = 0;
+  for (auto _ : state) {
+    moveSticks(frame++);
+    g_tmr10ms++;
+    luaTask(0, RUN_MIX_SCRIPT, false);
+  }
+  state.SetItemsProcessed(state.iterations() * scripts);
+
+  memclear(g_model.scriptsData, sizeof(g_model.scriptsData));
+  LUA_LOAD_MODEL_SCRIPTS();
+}
+BENCHMARK(Lua_luaTaskMixScripts)->Arg(1)->Arg(MAX_SCRIPTS);
+
+#endif
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "benchmarks.h"
+
+static void Mixer_evalMixes(benchmark::State & state)
+{
+  setupBenchmarkModel();
+  uint32_t frame = 0;
+  for (auto _ : state) {
+    moveSticks(frame++);
+    evalMixes(1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Mixer_evalMixes);
+
+static void Mixer_evalLogicalSwitches(benchmark::State & state)
+{
+  setupBenchmarkModel();
+  for (auto _ : state) {
+    g_tmr10ms++;
+    evalLogicalSwitches();
+  }
+  state.SetItemsProcessed(state.iterations() * 32);
+}
+BENCHMARK(Mixer_evalLogicalSwitches);
+
+static void Mixer_applyCurve(benchmark::State & state)
+{
+  static const char * const labels[] = { "diff", "expo", "func", "5 points", "9 points smooth", "17 points custom smooth" };
+  CurveRef curves[] = {
+    { CURVE_REF_DIFF, 30 },
+    { CURVE_REF_EXPO, 40 },
+    { CURVE_REF_FUNC, CURVE_ABS_X },
+    { CURVE_REF_CUSTOM, 1 },
+    { CURVE_REF_CUSTOM, 2 },
+    { CURVE_REF_CUSTOM, 3 },
+  };
+
+  setupBenchmarkModel();
+  CurveRef & curve = curves[state.range(0)];
+  int x = -RESX;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(applyCurve(x, curve));
+    x = (x >= RESX) ? -RESX : x + 7;
+  }
+  state.SetLabel(labels[state.range(0)]);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Mixer_applyCurve)->DenseRange(0, 5);
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "benchmarks.h"
+
+// Custom FrSky S.PORT sensors: 16 ids, then the same ids with other physical ids
+static void Telemetry_setTelemetryValue(benchmark::State & state)
+{
+  int sensors = state.range(0);
+
+  setupBenchmarkModel();
+  telemetryData.clear();
+  for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+    telemetryItems[i].clear();
+  }
+  memclear(g_model.telemetrySensors, sizeof(g_model.telemetrySensors));
+  invalidateTelemetrySensorsIndex();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  telemetryData.telemetryValid = 0x07;
+  allowNewSensors = true;
+
+  // the first value of each sensor creates it
+  for (int i = 0; i < sensors; i++) {
+    setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, T1_FIRST_ID + (i % 16), 0, i / 16, i, UNIT_CELSIUS, 0);
+  }
+
+  int i = 0;
+  int32_t value = 0;
+  for (auto _ : state) {
+    setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, T1_FIRST_ID + (i % 16), 0, i / 16, value++, UNIT_CELSIUS, 0);
+    if (++i == sensors) {
+      i = 0;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Telemetry_setTelemetryValue)->Arg(1)->Arg(8)->Arg(32);
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <algorithm>
+#include <string>
+#include "benchmarks.h"
+
+#if defined(SDCARD_YAML)
+
+#include "storage/yaml/yaml_tree_walker.h"
+#include "storage/yaml/yaml_parser.h"
+#include "storage/yaml/yaml_datastructs.h"
+
+// same chunk size as the SD card reader
+#define YAML_CHUNK_SIZE 512
+
+static bool yamlStringWriter(void * opaque, const char * str, size_t len)
+{
+  ((std::string *)opaque)->append(str, len);
+  return true;
+}
+
+static void Yaml_parseModel(benchmark::State & state)
+{
+  setupBenchmarkModel();
+  for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+    TelemetrySensor & sensor = g_model.telemetrySensors[i];
+    sensor.id = 0x0100 + i;
+    sensor.instance = i;
+    sensor.unit = UNIT_VOLTS;
+    sensor.prec = 1;
+    strncpy(sensor.label, "Sens", TELEM_LABEL_LEN);
+  }
+
+  std::string yaml;
+  YamlTreeWalker writer;
+  writer.reset(get_modeldata_nodes(), (uint8_t *)&g_model);
+  if (!writer.generate(yamlStringWriter, &yaml)) {
+    state.SkipWithError("YAML generation failed");
+    return;
+  }
+
+  static ModelData model;
+  for (auto _ : state) {
+    memset(&model, 0, sizeof(model));
+    YamlTreeWalker tree;
+    tree.reset(get_modeldata_nodes(), (uint8_t *)&model);
+    YamlParser parser;
+    parser.init(YamlTreeWalker::get_parser_calls(), &tree);
+    for (size_t offset = 0; offset < yaml.size(); offset += YAML_CHUNK_SIZE) {
+      unsigned int size = std::min<size_t>(YAML_CHUNK_SIZE, yaml.size() - offset);
+      if (parser.parse(yaml.data() + offset, size) != YamlParser::CONTINUE_PARSING) {
+        break;
+      }
+    }
+    benchmark::ClobberMemory();
+  }
+
+  if (memcmp(model.mixData, g_model.mixData, sizeof(g_model.mixData))) {
+    state.SkipWithError("parsed model differs");
+  }
+  state.SetBytesProcessed(state.iterations() * yaml.size());
+}
+BENCHMARK(Yaml_parseModel);
+
+#endif
@@ -31,20 +31,44 @@ private:
   });
   struct Bin Bins[NUM_BINS];
   int NoUsedBins;
+  int PeakUsedBins;
+  unsigned int NoFailures;
+  int FirstFreeBin;  // the free bins are chained through their data
+
+  static_assert(SIZE_SLOT >= sizeof(int16_t), "BinAllocator slot too small");
+
+  int getNextFreeBin(int n) {
+    int16_t next;
+    memcpy(&next, Bins[n].data, sizeof(next));
+    return next;
+  }
+  void setNextFreeBin(int n, int next) {
+    int16_t value = next;
+    memcpy(Bins[n].data, &value, sizeof(value));
+  }
 public:
-  BinAllocator() : NoUsedBins(0) {
+  BinAllocator() : NoUsedBins(0), PeakUsedBins(0), NoFailures(0), FirstFreeBin(0) {
     memclear(Bins, sizeof(Bins));
+    for (int n = 0; n < NUM_BINS; ++n) {
+      setNextFreeBin(n, n + 1 < NUM_BINS ? n + 1 : -1);
+    }
   }
   bool free(void * ptr) {
-    for (size_t n = 0; n < NUM_BINS; ++n) {
-      if (ptr == Bins[n].data) {
-        Bins[n].Used = false;
-        --NoUsedBins;
-        // TRACE("\tBinAllocator<%d> free %lu ------", SIZE_SLOT, n);
-        return true;
-      }
+    if (!is_member(ptr)) {
+      return false;
+    }
+    int n = ((char *)ptr - Bins[0].data) / sizeof(Bin);
+    if (ptr != Bins[n].data) {
+      return false;
+    }
+    if (Bins[n].Used) {
+      Bins[n].Used = false;
+      setNextFreeBin(n, FirstFreeBin);
+      FirstFreeBin = n;
+      --NoUsedBins;
     }
-    return false;
+    // TRACE("\tBinAllocator<%d> free %d ------", SIZE_SLOT, n);
+    return true;
   }
   bool is_member(void * ptr) {
     return (ptr >= Bins[0].data && ptr <= Bins[NUM_BINS-1].data);
@@ -54,20 +78,19 @@ public:
       // TRACE("BinAllocator<%d> malloc [%lu] size > SIZE_SLOT", SIZE_SLOT, size);
       return 0;
     }
-    if (NoUsedBins >= NUM_BINS) {
+    if (FirstFreeBin < 0) {
       // TRACE("BinAllocator<%d> malloc [%lu] no free slots", SIZE_SLOT, size);
+      ++NoFailures;
       return 0;
     }
-    for (size_t n = 0; n < NUM_BINS; ++n) {
-      if (!Bins[n].Used) {
-        Bins[n].Used = true;
-        ++NoUsedBins;
-        // TRACE("\tBinAllocator<%d> malloc %lu[%lu]", SIZE_SLOT, n, size);
-        return Bins[n].data;
-      }
+    int n = FirstFreeBin;
+    FirstFreeBin = getNextFreeBin(n);
+    Bins[n].Used = true;
+    if (++NoUsedBins > PeakUsedBins) {
+      PeakUsedBins = NoUsedBins;
     }
-    // TRACE("BinAllocator<%d> malloc [%lu] no free slots", SIZE_SLOT , size);
-    return 0;
+    // TRACE("\tBinAllocator<%d> malloc %d[%lu]", SIZE_SLOT, n, size);
+    return Bins[n].data;
   }
   size_t size(void * ptr) {
     return is_member(ptr) ? SIZE_SLOT : 0;
@@ -77,6 +100,8 @@ public:
   }
   unsigned int capacity() { return NUM_BINS; }
   unsigned int size() { return NoUsedBins; }
+  unsigned int peak() { return PeakUsedBins; }
+  unsigned int failures() { return NoFailures; }
 };
 
 #if defined(SIMU)
@@ -24,6 +24,10 @@
 #include <malloc.h>
 #include <new>
 
+#if defined(USE_BIN_ALLOCATOR)
+#include "bin_allocator.h"
+#endif
+
 #define CLI_COMMAND_MAX_ARGS           8
 #define CLI_COMMAND_MAX_LEN            256
 
@@ -752,6 +756,11 @@ int cliMemoryInfo(const char ** argv)
   serialPrint("------------");
   serialPrint("\tTotal   %u", s + w + e);
 #endif
+#if defined(USE_BIN_ALLOCATOR)
+  serialPrint("\nLua bins:");
+  serialPrint("\tslots1  %u/%u used, %u peak, %u failed", slots1.size(), slots1.capacity(), slots1.peak(), slots1.failures());
+  serialPrint("\tslots2  %u/%u used, %u peak, %u failed", slots2.size(), slots2.capacity(), slots2.peak(), slots2.failures());
+#endif
 #endif
   return 0;
 }
@@ -942,6 +951,24 @@ void printAudioVars()
   serialPrint("audioMutex[%u] = %u", (uint32_t)audioMutex, (uint32_t)MutexTbl[audioMutex].mutexFlag);
 }
 
+void printMixerTimingHistogram(const char * name, const MixerTimingHistogram & histogram)
+{
+  serialPrint("%s: max %uus", name, histogram.max / 2);
+  for (int n = 0; n < MIXER_TIMING_BUCKETS; n++) {
+    if (n < MIXER_TIMING_BUCKETS - 1)
+      serialPrint("\t< %uus: %u", 256 << n, histogram.counts[n]);
+    else
+      serialPrint("\t>= %uus: %u", 256 << (n - 1), histogram.counts[n]);
+  }
+}
+
+void printMixerTimingStats()
+{
+  printMixerTimingHistogram("Period", mixerTimingStats.period);
+  printMixerTimingHistogram("Mixer", mixerTimingStats.duration);
+  printMixerTimingHistogram("Pulses", mixerTimingStats.pulses);
+  mixerTimingStats.reset();
+}
 
 int cliDisplay(const char ** argv)
 {
@@ -1067,11 +1094,14 @@ int cliDisplay(const char ** argv)
   else if (!strcmp(argv[1], "audio")) {
     printAudioVars();
   }
+  else if (!strcmp(argv[1], "mixer")) {
+    printMixerTimingStats();
+  }
 #if defined(DISK_CACHE)
   else if (!strcmp(argv[1], "dc")) {
     DiskCacheStats stats = diskCache.getStats();
     uint32_t hitRate = diskCache.getHitRate();
-    serialPrint("Disk Cache stats: w:%u r: %u, h: %u(%0.1f%%), m: %u", stats.noWrites, (stats.noHits + stats.noMisses), stats.noHits, hitRate*0.1f, stats.noMisses);
+    serialPrint("Disk Cache stats: w:%u (h: %u) r: %u, h: %u(%0.1f%%), m: %u", stats.noWrites, stats.noWriteHits, (stats.noHits + stats.noMisses), stats.noHits, hitRate*0.1f, stats.noMisses);
   }
 #endif
   else if (toLongLongInt(argv, 1, &address) > 0) {
@@ -26,6 +26,29 @@
 
 int8_t * curveEnd[MAX_CURVES];
 
+// smooth curves tangents, recomputed on first use after each model change
+// (2KB: custom curves with points 1% apart have tangents up to 3*200*MMULT, which int16_t can't hold)
+static int32_t curveTangents[MAX_CURVES][MAX_POINTS_PER_CURVE];
+static volatile uint32_t curveTangentsVersion[MAX_CURVES];
+static volatile uint32_t curveTangentsGeneration = 1;
+static bool curveTangentsEdited;
+
+void invalidateCurveTangents()
+{
+  curveTangentsGeneration++;
+  curveTangentsEdited = true;
+}
+
+// storageDirty() is most often called before the edited value is stored,
+// the mixer may have computed the tangents again in between
+void invalidateEditedCurveTangents()
+{
+  if (curveTangentsEdited) {
+    curveTangentsEdited = false;
+    curveTangentsGeneration++;
+  }
+}
+
 void loadCurves()
 {
   bool showWarning= false;
@@ -55,6 +78,7 @@ void loadCurves()
     curveEnd[i] = tmp;
 
   }
+  invalidateCurveTangents();
   if (showWarning) {
     POPUP_WARNING("Invalid curve data repaired", "check your curves, logic switches");
   }
@@ -187,6 +211,25 @@ int32_t compute_tangent(CurveHeader * crv, const int8_t * points, int i)
     return m;
 }
 
+static const int32_t * getCurveTangents(uint8_t idx)
+{
+  uint32_t generation = curveTangentsGeneration;
+  if (curveTangentsVersion[idx] != generation) {
+    // not valid while being computed (the GUI and the mixer may both get there)
+    curveTangentsVersion[idx] = 0;
+    CurveHeader & crv = g_model.curves[idx];
+    int8_t * points = curveAddress(idx);
+    for (int i = 0; i < crv.points + 5 && i < MAX_POINTS_PER_CURVE; i++) {
+      curveTangents[idx][i] = compute_tangent(&crv, points, i);
+    }
+    // published once complete, unless the model was changed in the meantime
+    if (curveTangentsGeneration == generation) {
+      curveTangentsVersion[idx] = generation;
+    }
+  }
+  return curveTangents[idx];
+}
+
 /* The following is a hermite cubic spline.
    The basis functions can be found here:
    http://en.wikipedia.org/wiki/Cubic_Hermite_spline
@@ -198,6 +241,7 @@ int16_t hermite_spline(int16_t x, uint8_t idx)
   int8_t *points = curveAddress(idx);
   uint8_t count = crv.points+5;
   bool custom = (crv.type == CURVE_TYPE_CUSTOM);
+  const int32_t * tangents = getCurveTangents(idx);
 
   if (x < -RESX)
     x = -RESX;
@@ -218,8 +262,8 @@ int16_t hermite_spline(int16_t x, uint8_t idx)
     if (x >= p0x && x <= p3x) {
       int32_t p0y = calc100toRESX(points[i]);
       int32_t p3y = calc100toRESX(points[i+1]);
-      int32_t m0 = compute_tangent(&crv, points, i);
-      int32_t m3 = compute_tangent(&crv, points, i+1);
+      int32_t m0 = tangents[i];
+      int32_t m3 = tangents[i+1];
       int32_t y;
       int32_t h = p3x - p0x;
       int32_t t = (h > 0 ? (MMULT * (x - p0x)) / h : 0);
@@ -21,11 +21,6 @@
 #include <string.h>
 #include "opentx.h"
 
-#if defined(SIMU) && !defined(SIMU_DISKIO)
-  #define __disk_read(...)    (RES_OK)
-  #define __disk_write(...)   (RES_OK)
-#endif
-
 #if 0     // set to 1 to enable traces
   #define TRACE_DISK_CACHE(...)   TRACE(__VA_ARGS__)
 #else
@@ -35,6 +30,7 @@
 DiskCache diskCache;
 
 DiskCacheBlock::DiskCacheBlock():
+  lastUse(0),
   startSector(0),
   endSector(0) 
 {
@@ -63,6 +59,19 @@ DRESULT DiskCacheBlock::fill(BYTE drv, BYTE * buff, DWORD sector, UINT count)
   return RES_OK;
 }
 
+bool DiskCacheBlock::write(const BYTE * buff, DWORD sector, UINT count)
+{
+  // keep the cached copy of the written sectors up to date
+  DWORD first = (sector > startSector ? sector : startSector);
+  DWORD last = (sector+count < endSector ? sector+count : endSector);
+  if (first < last) {
+    TRACE_DISK_CACHE("\tcache write(%u, %u) to %p", (uint32_t)first, (uint32_t)(last-first), this);
+    memcpy(data + ((first - startSector) * BLOCK_SIZE), buff + ((first - sector) * BLOCK_SIZE), (last - first) * BLOCK_SIZE);
+    return true;
+  }
+  return false;
+}
+
 void DiskCacheBlock::free(DWORD sector, UINT count) 
 {
   if (sector < endSector && (sector+count) > startSector) {
@@ -82,22 +91,25 @@ bool DiskCacheBlock::empty() const
 }
 
 DiskCache::DiskCache():
-  lastBlock(0)
+  useCounter(0)
 {
   stats.noHits = 0;
   stats.noMisses = 0;
   stats.noWrites = 0;
+  stats.noWriteHits = 0;
   blocks = new DiskCacheBlock[DISK_CACHE_BLOCKS_NUM];
 }
 
 void DiskCache::clear()
 {
-  lastBlock = 0;
+  useCounter = 0;
   stats.noHits = 0;
   stats.noMisses = 0;
   stats.noWrites = 0;
+  stats.noWriteHits = 0;
   for (int n=0; n<DISK_CACHE_BLOCKS_NUM; ++n) {
     blocks[n].free();
+    blocks[n].lastUse = 0;
   }
 }
 
@@ -121,8 +133,11 @@ DRESULT DiskCache::read(BYTE drv, BYTE * buff, DWORD sector, UINT count)
     return __disk_read(drv, buff, sector, count);
   }
 
+  ++useCounter;
+
   for (int n=0; n<DISK_CACHE_BLOCKS_NUM; ++n) {
     if (blocks[n].read(buff, sector, count)) {
+      blocks[n].lastUse = useCounter;
       ++stats.noHits;
       return RES_OK;
     }
@@ -130,30 +145,36 @@ DRESULT DiskCache::read(BYTE drv, BYTE * buff, DWORD sector, UINT count)
 
   ++stats.noMisses;
 
-  // find free block
+  // use a free block, or else the least recently used one
+  DiskCacheBlock * victim = &blocks[0];
   for (int n=0; n<DISK_CACHE_BLOCKS_NUM; ++n) {
     if (blocks[n].empty()) {
       TRACE_DISK_CACHE("\t\t using free block");
-      return blocks[n].fill(drv, buff, sector, count);
+      victim = &blocks[n];
+      break;
+    }
+    if (useCounter - blocks[n].lastUse > useCounter - victim->lastUse) {
+      victim = &blocks[n];
     }
   }
 
-  // use next block (round robin)
-  // TODO: use better strategy to select which used block gets used here
-  if (++lastBlock >= DISK_CACHE_BLOCKS_NUM) {
-    lastBlock = 0;
-  }
-  
-  return blocks[lastBlock].fill(drv, buff, sector, count);
+  victim->lastUse = useCounter;
+  return victim->fill(drv, buff, sector, count);
 }
 
 DRESULT DiskCache::write(BYTE drv, const BYTE* buff, DWORD sector, UINT count)
 {
   ++stats.noWrites;
-  for(int n=0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
-    blocks[n].free(sector, count);
+  DRESULT res = __disk_write(drv, buff, sector, count);
+  for (int n=0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
+    if (res != RES_OK) {
+      blocks[n].free(sector, count);
+    }
+    else if (!blocks[n].empty() && blocks[n].write(buff, sector, count)) {
+      ++stats.noWriteHits;
+    }
   }
-  return __disk_write(drv, buff, sector, count);  
+  return res;
 }
 
 const DiskCacheStats & DiskCache::getStats() const 
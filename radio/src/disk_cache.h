@@ -36,10 +36,13 @@ public:
   DiskCacheBlock();
   bool read(BYTE* buff, DWORD sector, UINT count);
   DRESULT fill(BYTE drv, BYTE* buff, DWORD sector, UINT count);
+  bool write(const BYTE* buff, DWORD sector, UINT count);
   void free(DWORD sector, UINT count);
   void free();
   bool empty() const;
 
+  uint32_t lastUse;
+
 private:
   uint8_t data[DISK_CACHE_BLOCK_SIZE];
   DWORD startSector;
@@ -51,6 +54,7 @@ struct DiskCacheStats
   uint32_t noHits;
   uint32_t noMisses;
   uint32_t noWrites;
+  uint32_t noWriteHits;  // writes which updated cached sectors
 };
 
 class DiskCache
@@ -65,7 +69,7 @@ class DiskCache
 
   private:
     DiskCacheStats stats;
-    uint32_t lastBlock;
+    uint32_t useCounter;
     DiskCacheBlock * blocks;
 };
 
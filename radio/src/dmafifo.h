@@ -21,6 +21,7 @@
 #ifndef _DMA_FIFO_H_
 #define _DMA_FIFO_H_
 
+#include <string.h>
 #include "definitions.h"
 
 template <int N>
@@ -68,6 +69,27 @@ class DMAFifo
       }
     }
 
+    // returns the number of bytes popped
+    uint32_t popBlock(uint8_t * elements, uint32_t count)
+    {
+#if defined(SIMU)
+      return 0;
+#endif
+      uint32_t widx = N - stream->NDTR;
+      uint32_t available = (N + widx - ridx) & (N - 1);
+      if (count > available) {
+        count = available;
+      }
+      uint32_t first = N - ridx;
+      if (first > count) {
+        first = count;
+      }
+      memcpy(elements, &fifo[ridx], first);
+      memcpy(elements + first, &fifo[0], count - first);
+      ridx = (ridx + count) & (N - 1);
+      return count;
+    }
+
     uint8_t * buffer()
     {
       return fifo;
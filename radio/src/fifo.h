@@ -22,7 +22,13 @@
 #define _FIFO_H_
 
 #include <inttypes.h>
+#include <atomic>
 
+// Single producer / single consumer ring buffer, typically filled from an
+// ISR and drained from a task (or the opposite).
+// Only the producer writes widx and only the consumer writes ridx: the
+// element accesses are ordered against the index updates with signal
+// fences, which is all we need on our single core targets.
 template <class T, int N>
 class Fifo
 {
@@ -31,27 +37,51 @@ class Fifo
   public:
     Fifo():
       widx(0),
-      ridx(0)
+      ridx(0),
+      overruns(0)
     {
     }
 
     void clear()
     {
       widx = ridx = 0;
+      overruns = 0;
     }
 
-    void push(T element)
+    bool push(T element)
     {
       uint32_t next = nextIndex(widx);
-      if (next != ridx) {
-        fifo[widx] = element;
-        widx = next;
+      if (next == loadIndex(ridx)) {
+        overruns++;
+        return false;
+      }
+      fifo[widx] = element;
+      storeIndex(widx, next);
+      return true;
+    }
+
+    // returns the number of elements pushed, the others are counted as overruns
+    uint32_t pushBlock(const T * elements, uint32_t count)
+    {
+      uint32_t w = widx;
+      uint32_t space = (N - 1 + loadIndex(ridx) - w) & (N - 1);
+      if (count > space) {
+        overruns += count - space;
+        count = space;
+      }
+      uint32_t first = N - w;
+      if (first > count) {
+        first = count;
       }
+      copy(&fifo[w], elements, first);
+      copy(&fifo[0], elements + first, count - first);
+      storeIndex(widx, (w + count) & (N - 1));
+      return count;
     }
 
     void skip()
     {
-      ridx = nextIndex(ridx);
+      storeIndex(ridx, nextIndex(ridx));
     }
 
     bool pop(T & element)
@@ -61,14 +91,32 @@ class Fifo
       }
       else {
         element = fifo[ridx];
-        ridx = nextIndex(ridx);
+        storeIndex(ridx, nextIndex(ridx));
         return true;
       }
     }
 
+    // returns the number of elements popped
+    uint32_t popBlock(T * elements, uint32_t count)
+    {
+      uint32_t r = ridx;
+      uint32_t available = (N + loadIndex(widx) - r) & (N - 1);
+      if (count > available) {
+        count = available;
+      }
+      uint32_t first = N - r;
+      if (first > count) {
+        first = count;
+      }
+      copy(elements, &fifo[r], first);
+      copy(elements + first, &fifo[0], count - first);
+      storeIndex(ridx, (r + count) & (N - 1));
+      return count;
+    }
+
     bool isEmpty() const
     {
-      return (ridx == widx);
+      return (ridx == loadIndex(widx));
     }
 
     bool isFull() const
@@ -98,15 +146,44 @@ class Fifo
       }
     }
 
+    // number of elements dropped because the fifo was full
+    uint32_t getOverruns() const
+    {
+      return overruns;
+    }
+
   protected:
     T fifo[N];
     volatile uint32_t widx;
     volatile uint32_t ridx;
+    volatile uint32_t overruns;
 
     static inline uint32_t nextIndex(uint32_t idx)
     {
       return (idx + 1) & (N - 1);
     }
+
+    // the other side index is read before accessing the elements ...
+    static inline uint32_t loadIndex(const volatile uint32_t & idx)
+    {
+      uint32_t result = idx;
+      std::atomic_signal_fence(std::memory_order_acquire);
+      return result;
+    }
+
+    // ... and our own index is published once the elements are accessed
+    static inline void storeIndex(volatile uint32_t & idx, uint32_t value)
+    {
+      std::atomic_signal_fence(std::memory_order_release);
+      idx = value;
+    }
+
+    static inline void copy(T * destination, const T * source, uint32_t count)
+    {
+      for (uint32_t i = 0; i < count; i++) {
+        destination[i] = source[i];
+      }
+    }
 };
 
 #endif // _FIFO_H_
@@ -20,6 +20,10 @@
 
 #include "opentx.h"
 
+#if defined(USE_BIN_ALLOCATOR)
+#include "bin_allocator.h"
+#endif
+
 #define STATS_1ST_COLUMN               1
 #define STATS_2ND_COLUMN               7*FW+FW/2
 #define STATS_3RD_COLUMN               14*FW+FW/2
@@ -137,6 +141,7 @@ void menuStatisticsDebug(event_t event)
       maxLuaDuration = 0;
 #endif
       maxMixerDuration  = 0;
+      mixerTimingStats.reset();
       break;
 
     case EVT_KEY_FIRST(KEY_UP):
@@ -246,6 +251,13 @@ void menuStatisticsDebug(event_t event)
   lcdDrawText(lcdLastRightPos, y, "ms");
   y += FH;
 
+  // max mixer period and [P]ulses duration, in ms (no room for the units)
+  lcdDrawTextAlignedLeft(y, "Mix period");
+  lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, DURATION_MS_PREC2(mixerTimingStats.period.max), PREC2|LEFT);
+  lcdDrawText(lcdLastRightPos+2, y+1, "[P]", SMLSIZE);
+  lcdDrawNumber(lcdLastRightPos, y, DURATION_MS_PREC2(mixerTimingStats.pulses.max), PREC2|LEFT);
+  y += FH;
+
   lcdDrawTextAlignedLeft(y, STR_FREE_STACK);
   lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, menusStack.available(), LEFT);
   lcdDrawText(lcdLastRightPos, y, "/");
@@ -268,6 +280,19 @@ void menuStatisticsDebug(event_t event)
 }
 
 #if defined(STM32)
+#if defined(USE_BIN_ALLOCATOR)
+template <class T>
+void drawBinAllocatorStats(coord_t y, const char * name, T & allocator)
+{
+  lcdDrawTextAlignedLeft(y, name);
+  lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, allocator.size(), LEFT);
+  lcdDrawChar(lcdLastRightPos, y, '/');
+  lcdDrawNumber(lcdLastRightPos, y, allocator.peak(), LEFT);
+  lcdDrawText(lcdLastRightPos+2, y+1, "[F]", SMLSIZE);
+  lcdDrawNumber(lcdLastRightPos, y, allocator.failures(), LEFT);
+}
+#endif
+
 void menuStatisticsDebug2(event_t event)
 {
   title(STR_MENUDEBUG);
@@ -275,6 +300,12 @@ void menuStatisticsDebug2(event_t event)
   switch(event) {
     case EVT_KEY_FIRST(KEY_ENTER):
       telemetryErrors  = 0;
+#if defined(EEPROM_RLC)
+      eepromWriteStats.reset();
+#endif
+#if defined(LUA)
+      luaResetCpuTime();
+#endif
       break;
 
     case EVT_KEY_FIRST(KEY_UP):
@@ -313,6 +344,34 @@ void menuStatisticsDebug2(event_t event)
   y += FH;
 #endif
 
+#if defined(USE_BIN_ALLOCATOR)
+  drawBinAllocatorStats(y, "Lua bins1", slots1);
+  y += FH;
+  drawBinAllocatorStats(y, "Lua bins2", slots2);
+  y += FH;
+#endif
+
+#if defined(EEPROM_RLC)
+  lcdDrawTextAlignedLeft(y, "EEPROM");
+  lcdDrawText(MENU_DEBUG_COL1_OFS, y+1, "[W]", SMLSIZE);
+  lcdDrawNumber(lcdLastRightPos, y, eepromWriteStats.writes, LEFT);
+  lcdDrawText(lcdLastRightPos+2, y+1, "[S]", SMLSIZE);
+  lcdDrawNumber(lcdLastRightPos, y, eepromWriteStats.skipped, LEFT);
+  lcdDrawText(lcdLastRightPos+2, y+1, "[B]", SMLSIZE);
+  lcdDrawNumber(lcdLastRightPos, y, eepromWriteStats.blocks, LEFT);
+  y += FH;
+#endif
+
+#if defined(LUA)
+  // max CPU time of one run of each script
+  lcdDrawTextAlignedLeft(y, "Lua CPU");
+  lcdDrawText(MENU_DEBUG_COL1_OFS, y+1, "[ms]", SMLSIZE);
+  for (int i = 0; i < luaScriptsCount && lcdLastRightPos < LCD_W - 4*FW; i++) {
+    lcdDrawNumber(lcdLastRightPos+3, y, luaGetCpuTime(i) / 100, LEFT|PREC1);
+  }
+  y += FH;
+#endif
+
   lcdDrawText(LCD_W/2, 7*FH+1, STR_MENUTORESET, CENTERED);
   lcdInvertLastLine();
 }
@@ -20,6 +20,10 @@
 
 #include "opentx.h"
 
+#if defined(USE_BIN_ALLOCATOR)
+#include "bin_allocator.h"
+#endif
+
 #define STATS_1ST_COLUMN               FW/2
 #define STATS_2ND_COLUMN               12*FW+FW/2
 #define STATS_3RD_COLUMN               24*FW+FW/2
@@ -129,6 +133,7 @@ void menuStatisticsDebug(event_t event)
       maxLuaDuration = 0;
 #endif
       maxMixerDuration  = 0;
+      mixerTimingStats.reset();
       break;
 
     case EVT_KEY_FIRST(KEY_UP):
@@ -193,6 +198,9 @@ void menuStatisticsDebug(event_t event)
   lcdDrawTextAlignedLeft(y, STR_TMIXMAXMS);
   lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, DURATION_MS_PREC2(maxMixerDuration), PREC2|LEFT);
   lcdDrawText(lcdLastRightPos, y, "ms");
+  lcdDrawText(lcdLastRightPos+2, y+1, "[Period]", SMLSIZE);
+  lcdDrawNumber(lcdLastRightPos, y, DURATION_MS_PREC2(mixerTimingStats.period.max), PREC2|LEFT);
+  lcdDrawText(lcdLastRightPos, y, "ms");
   y += FH;
 
   lcdDrawTextAlignedLeft(y, STR_FREE_STACK);
@@ -219,6 +227,19 @@ void menuStatisticsDebug(event_t event)
   lcdInvertLastLine();
 }
 
+#if defined(USE_BIN_ALLOCATOR)
+template <class T>
+void drawBinAllocatorStats(coord_t y, const char * name, T & allocator)
+{
+  lcdDrawTextAlignedLeft(y, name);
+  lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, allocator.size(), LEFT);
+  lcdDrawChar(lcdLastRightPos, y, '/');
+  lcdDrawNumber(lcdLastRightPos, y, allocator.peak(), LEFT);
+  lcdDrawText(lcdLastRightPos+2, y+1, "[F]", SMLSIZE);
+  lcdDrawNumber(lcdLastRightPos, y, allocator.failures(), LEFT);
+}
+#endif
+
 void menuStatisticsDebug2(event_t event)
 {
   title(STR_MENUDEBUG);
@@ -245,6 +266,12 @@ void menuStatisticsDebug2(event_t event)
 
     case EVT_KEY_LONG(KEY_ENTER):
       telemetryErrors = 0;
+#if defined(EEPROM_RLC)
+      eepromWriteStats.reset();
+#endif
+#if defined(LUA)
+      luaResetCpuTime();
+#endif
       break;
   }
 
@@ -252,6 +279,29 @@ void menuStatisticsDebug2(event_t event)
   lcdDrawTextAlignedLeft(MENU_DEBUG_ROW1, "Tlm RX Err");
   lcdDrawNumber(MENU_DEBUG_COL1_OFS, MENU_DEBUG_ROW1, telemetryErrors, RIGHT);
 
+#if defined(USE_BIN_ALLOCATOR)
+  drawBinAllocatorStats(MENU_DEBUG_ROW2, "Lua bins1", slots1);
+  drawBinAllocatorStats(MENU_DEBUG_ROW3, "Lua bins2", slots2);
+#endif
+
+#if defined(EEPROM_RLC)
+  lcdDrawTextAlignedLeft(MENU_DEBUG_ROW4, "EEPROM");
+  lcdDrawText(MENU_DEBUG_COL1_OFS, MENU_DEBUG_ROW4+1, "[W]", SMLSIZE);
+  lcdDrawNumber(lcdLastRightPos, MENU_DEBUG_ROW4, eepromWriteStats.writes, LEFT);
+  lcdDrawText(lcdLastRightPos+2, MENU_DEBUG_ROW4+1, "[S]", SMLSIZE);
+  lcdDrawNumber(lcdLastRightPos, MENU_DEBUG_ROW4, eepromWriteStats.skipped, LEFT);
+  lcdDrawText(lcdLastRightPos+2, MENU_DEBUG_ROW4+1, "[B]", SMLSIZE);
+  lcdDrawNumber(lcdLastRightPos, MENU_DEBUG_ROW4, eepromWriteStats.blocks, LEFT);
+#endif
+
+#if defined(LUA)
+  // max CPU time of one run of each script
+  lcdDrawTextAlignedLeft(MENU_DEBUG_ROW5, "Lua CPU");
+  lcdDrawText(MENU_DEBUG_COL1_OFS, MENU_DEBUG_ROW5+1, "[ms]", SMLSIZE);
+  for (int i = 0; i < luaScriptsCount && lcdLastRightPos < LCD_W - 4*FW; i++) {
+    lcdDrawNumber(lcdLastRightPos+3, MENU_DEBUG_ROW5, luaGetCpuTime(i) / 100, LEFT|PREC1);
+  }
+#endif
 
   lcdDrawText(LCD_W/2, 7*FH+1, STR_MENUTORESET, CENTERED);
   lcdInvertLastLine();
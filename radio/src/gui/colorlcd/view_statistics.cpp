@@ -156,6 +156,15 @@ void DebugViewPage::build(FormWindow * window)
   }, PREC2, nullptr, "ms");
   grid.nextLine();
 
+  // Mixer timing data
+  new DebugInfoNumber<uint16_t>(window, grid.getFieldSlot(3, 0), [] {
+      return DURATION_MS_PREC2(mixerTimingStats.period.max);
+  }, PREC2, "[Period] ", "ms");
+  new DebugInfoNumber<uint16_t>(window, grid.getFieldSlot(3, 1), [] {
+      return DURATION_MS_PREC2(mixerTimingStats.pulses.max);
+  }, PREC2, "[Pulses] ", "ms");
+  grid.nextLine();
+
   // Free mem
   new StaticText(window, grid.getLabelSlot(), STR_FREE_MEM_LABEL);
   new DynamicNumber<int>(window, grid.getFieldSlot(), [] {
@@ -185,6 +194,17 @@ void DebugViewPage::build(FormWindow * window)
       return luaExtraMemoryUsage;
   }, 0, "[B] ", nullptr);
   grid.nextLine();
+
+  // Lua scripts max CPU time of one run
+  static char cpuTimePrefixes[MAX_SCRIPTS][8];
+  for (int i = 0; i < luaScriptsCount; i++) {
+    snprintf(cpuTimePrefixes[i], sizeof(cpuTimePrefixes[i]), "[%d] ", i + 1);
+    new DebugInfoNumber<uint16_t>(window, grid.getFieldSlot(3, i % 3), [=] {
+        return luaGetCpuTime(i);
+    }, 0, cpuTimePrefixes[i], "us");
+    if (i % 3 == 2 || i == luaScriptsCount - 1)
+      grid.nextLine();
+  }
 #endif
 
   // Stacks data
@@ -229,9 +249,11 @@ void DebugViewPage::build(FormWindow * window)
   new TextButton (window, grid.getLineSlot(), STR_MENUTORESET,
      [=]() -> uint8_t {
          maxMixerDuration  = 0;
+         mixerTimingStats.reset();
 #if defined(LUA)
          maxLuaInterval = 0;
          maxLuaDuration = 0;
+         luaResetCpuTime();
 #endif
          return 0;
      }, BUTTON_BACKGROUND | NO_FOCUS);
@@ -29,8 +29,64 @@ FIL g_oLogFile __DMA;
 const char * g_logError = nullptr;
 uint8_t logDelay;
 
+// Rows are formatted into this buffer and written to the card by whole
+// sectors, instead of many small f_printf() calls per row
+#define LOGS_BUFFER_SIZE   512
+static char logsBuffer[LOGS_BUFFER_SIZE] __DMA;
+static uint16_t logsBufferCount = 0;
+static uint16_t logsBufferLimit = LOGS_BUFFER_SIZE;
+static bool logsWriteError = false;
+
 void writeHeader();
 
+static void logsFlush()
+{
+  if (logsBufferCount > 0) {
+    UINT written;
+    if (f_write(&g_oLogFile, logsBuffer, logsBufferCount, &written) != FR_OK || written != logsBufferCount) {
+      logsWriteError = true;
+    }
+    logsBufferCount = 0;
+  }
+  // keep the next writes aligned on the file sectors
+  logsBufferLimit = LOGS_BUFFER_SIZE - (f_tell(&g_oLogFile) % LOGS_BUFFER_SIZE);
+}
+
+static void logsAppend(const char * data, uint16_t len)
+{
+  while (len > 0) {
+    uint16_t count = min<uint16_t>(len, logsBufferLimit - logsBufferCount);
+    memcpy(&logsBuffer[logsBufferCount], data, count);
+    logsBufferCount += count;
+    data += count;
+    len -= count;
+    if (logsBufferCount >= logsBufferLimit) {
+      logsFlush();
+    }
+  }
+}
+
+static void logsPuts(const char * str)
+{
+  logsAppend(str, strlen(str));
+}
+
+static void logsPutc(char c)
+{
+  logsAppend(&c, 1);
+}
+
+static char * strAppendFixed(char * dest, int32_t value, uint32_t divisor, uint8_t digits)
+{
+  uint32_t absValue = (value < 0 ? -value : value);
+  if (value < 0) {
+    *dest++ = '-';
+  }
+  dest = strAppendUnsigned(dest, absValue / divisor);
+  *dest++ = '.';
+  return strAppendUnsigned(dest, absValue % divisor, digits);
+}
+
 #if defined(PCBFRSKY) || defined(PCBNV14)
   int getSwitchState(uint8_t swtch) {
     int value = getValue(MIXSRC_FIRST_SWITCH + swtch);
@@ -107,6 +163,10 @@ const char * logsOpen()
     return SDCARD_ERROR(result);
   }
 
+  logsBufferCount = 0;
+  logsWriteError = false;
+  logsFlush();
+
   if (f_size(&g_oLogFile) == 0) {
     writeHeader();
   }
@@ -119,6 +179,10 @@ tmr10ms_t lastLogTime = 0;
 void logsClose()
 {
   if (sdMounted()) {
+    if (g_oLogFile.obj.fs) {
+      logsFlush();
+    }
+    logsBufferCount = 0;
     if (f_close(&g_oLogFile) != FR_OK) {
       // close failed, forget file
       g_oLogFile.obj.fs = 0;
@@ -131,9 +195,9 @@ void logsClose()
 void writeHeader()
 {
 #if defined(RTCLOCK)
-  f_puts("Date,Time,", &g_oLogFile);
+  logsPuts("Date,Time,");
 #else
-  f_puts("Time,", &g_oLogFile);
+  logsPuts("Time,");
 #endif
 
 
@@ -152,7 +216,7 @@ void writeHeader()
           strcat(label, ")");
         }
         strcat(label, ",");
-        f_puts(label, &g_oLogFile);
+        logsPuts(label);
       }
     }
   }
@@ -162,10 +226,10 @@ void writeHeader()
     const char * p = STR_VSRCRAW + i * STR_VSRCRAW[0] + 2;
     for (uint8_t j=0; j<STR_VSRCRAW[0]-1; ++j) {
       if (!*p) break;
-      f_putc(*p, &g_oLogFile);
+      logsPutc(*p);
       ++p;
     }
-    f_putc(',', &g_oLogFile);
+    logsPutc(',');
   }
 
   for (uint8_t i=0; i<NUM_SWITCHES; i++) {
@@ -175,15 +239,15 @@ void writeHeader()
       temp = getSwitchName(s, SWSRC_FIRST_SWITCH + i * 3);
       *temp++ = ',';
       *temp = '\0';
-      f_puts(s, &g_oLogFile);
+      logsPuts(s);
     }
   }
-  f_puts("LSW,", &g_oLogFile);
+  logsPuts("LSW,");
 #else
-  f_puts("Rud,Ele,Thr,Ail,P1,P2,P3,THR,RUD,ELE,3POS,AIL,GEA,TRN,", &g_oLogFile);
+  logsPuts("Rud,Ele,Thr,Ail,P1,P2,P3,THR,RUD,ELE,3POS,AIL,GEA,TRN,");
 #endif
 
-  f_puts("TxBat(V)\n", &g_oLogFile);
+  logsPuts("TxBat(V)\n");
 }
 
 uint32_t getLogicalSwitchesStates(uint8_t first)
@@ -219,6 +283,9 @@ void logsWrite()
         }
       }
 
+      char buffer[32];
+      char * s;
+
 #if defined(RTCLOCK)
       {
         static struct gtm utm;
@@ -227,10 +294,26 @@ void logsWrite()
           lastRtcTime = g_rtcTime;
           gettime(&utm);
         }
-        f_printf(&g_oLogFile, "%4d-%02d-%02d,%02d:%02d:%02d.%02d0,", utm.tm_year+TM_YEAR_BASE, utm.tm_mon+1, utm.tm_mday, utm.tm_hour, utm.tm_min, utm.tm_sec, g_ms100);
+        s = strAppendUnsigned(buffer, utm.tm_year+TM_YEAR_BASE, 4);
+        *s++ = '-';
+        s = strAppendUnsigned(s, utm.tm_mon+1, 2);
+        *s++ = '-';
+        s = strAppendUnsigned(s, utm.tm_mday, 2);
+        *s++ = ',';
+        s = strAppendUnsigned(s, utm.tm_hour, 2);
+        *s++ = ':';
+        s = strAppendUnsigned(s, utm.tm_min, 2);
+        *s++ = ':';
+        s = strAppendUnsigned(s, utm.tm_sec, 2);
+        *s++ = '.';
+        s = strAppendUnsigned(s, g_ms100, 2);
+        strcpy(s, "0,");
+        logsPuts(buffer);
       }
 #else
-      f_printf(&g_oLogFile, "%d,", tmr10ms);
+      s = strAppendUnsigned(buffer, tmr10ms);
+      strcpy(s, ",");
+      logsPuts(buffer);
 #endif
 
       for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
@@ -238,65 +321,83 @@ void logsWrite()
           TelemetrySensor & sensor = g_model.telemetrySensors[i];
           TelemetryItem & telemetryItem = telemetryItems[i];
           if (sensor.logs) {
+            s = buffer;
             if (sensor.unit == UNIT_GPS) {
               if (telemetryItem.gps.longitude && telemetryItem.gps.latitude) {
-                div_t qr = div((int)telemetryItem.gps.latitude, 1000000);
-                if (telemetryItem.gps.latitude < 0) f_printf(&g_oLogFile, "-");
-                f_printf(&g_oLogFile, "%d.%06d ", abs(qr.quot), abs(qr.rem));
-                qr = div((int)telemetryItem.gps.longitude, 1000000);
-                if (telemetryItem.gps.longitude < 0) f_printf(&g_oLogFile, "-");
-                f_printf(&g_oLogFile, "%d.%06d,", abs(qr.quot), abs(qr.rem));
-              }
-              else {
-                f_printf(&g_oLogFile, ",");
+                s = strAppendFixed(s, telemetryItem.gps.latitude, 1000000, 6);
+                *s++ = ' ';
+                s = strAppendFixed(s, telemetryItem.gps.longitude, 1000000, 6);
               }
             }
             else if (sensor.unit == UNIT_DATETIME) {
-              f_printf(&g_oLogFile, "%4d-%02d-%02d %02d:%02d:%02d,", telemetryItem.datetime.year, telemetryItem.datetime.month, telemetryItem.datetime.day, telemetryItem.datetime.hour, telemetryItem.datetime.min, telemetryItem.datetime.sec);
+              s = strAppendUnsigned(s, telemetryItem.datetime.year, 4);
+              *s++ = '-';
+              s = strAppendUnsigned(s, telemetryItem.datetime.month, 2);
+              *s++ = '-';
+              s = strAppendUnsigned(s, telemetryItem.datetime.day, 2);
+              *s++ = ' ';
+              s = strAppendUnsigned(s, telemetryItem.datetime.hour, 2);
+              *s++ = ':';
+              s = strAppendUnsigned(s, telemetryItem.datetime.min, 2);
+              *s++ = ':';
+              s = strAppendUnsigned(s, telemetryItem.datetime.sec, 2);
             }
             else if (sensor.prec == 2) {
-              div_t qr = div((int)telemetryItem.value, 100);
-              if (telemetryItem.value < 0) f_printf(&g_oLogFile, "-");
-              f_printf(&g_oLogFile, "%d.%02d,", abs(qr.quot), abs(qr.rem));
+              s = strAppendFixed(s, telemetryItem.value, 100, 2);
             }
             else if (sensor.prec == 1) {
-              div_t qr = div((int)telemetryItem.value, 10);
-              if (telemetryItem.value < 0) f_printf(&g_oLogFile, "-");
-              f_printf(&g_oLogFile, "%d.%d,", abs(qr.quot), abs(qr.rem));
+              s = strAppendFixed(s, telemetryItem.value, 10, 1);
             }
             else {
-              f_printf(&g_oLogFile, "%d,", telemetryItem.value);
+              s = strAppendSigned(s, telemetryItem.value);
             }
+            *s++ = ',';
+            logsAppend(buffer, s - buffer);
           }
         }
       }
 
       for (uint8_t i=0; i<NUM_STICKS+NUM_POTS+NUM_SLIDERS; i++) {
-        f_printf(&g_oLogFile, "%d,", calibratedAnalogs[i]);
+        s = strAppendSigned(buffer, calibratedAnalogs[i]);
+        *s++ = ',';
+        logsAppend(buffer, s - buffer);
       }
 
 #if defined(PCBFRSKY) || defined(PCBFLYSKY)
       for (uint8_t i=0; i<NUM_SWITCHES; i++) {
         if (SWITCH_EXISTS(i)) {
-          f_printf(&g_oLogFile, "%d,", getSwitchState(i));
+          s = strAppendSigned(buffer, getSwitchState(i));
+          *s++ = ',';
+          logsAppend(buffer, s - buffer);
         }
       }
-      f_printf(&g_oLogFile, "0x%08X%08X,", getLogicalSwitchesStates(32), getLogicalSwitchesStates(0));
+      s = strAppend(buffer, "0x");
+      s = strAppendUnsigned(s, getLogicalSwitchesStates(32), 8, 16);
+      s = strAppendUnsigned(s, getLogicalSwitchesStates(0), 8, 16);
+      *s++ = ',';
+      logsAppend(buffer, s - buffer);
 #else
-      f_printf(&g_oLogFile, "%d,%d,%d,%d,%d,%d,%d,",
-          GET_2POS_STATE(THR),
-          GET_2POS_STATE(RUD),
-          GET_2POS_STATE(ELE),
-          GET_3POS_STATE(ID),
-          GET_2POS_STATE(AIL),
-          GET_2POS_STATE(GEA),
-          GET_2POS_STATE(TRN));
+      const int8_t states[] = {
+        GET_2POS_STATE(THR),
+        GET_2POS_STATE(RUD),
+        GET_2POS_STATE(ELE),
+        GET_3POS_STATE(ID),
+        GET_2POS_STATE(AIL),
+        GET_2POS_STATE(GEA),
+        GET_2POS_STATE(TRN)
+      };
+      for (uint8_t i=0; i<DIM(states); i++) {
+        s = strAppendSigned(buffer, states[i]);
+        *s++ = ',';
+        logsAppend(buffer, s - buffer);
+      }
 #endif
 
-      div_t qr = div(g_vbat100mV, 10);
-      int result = f_printf(&g_oLogFile, "%d.%d\n", abs(qr.quot), abs(qr.rem));
+      s = strAppendFixed(buffer, g_vbat100mV, 10, 1);
+      *s++ = '\n';
+      logsAppend(buffer, s - buffer);
 
-      if (result<0 && !error_displayed) {
+      if (logsWriteError && !error_displayed) {
         error_displayed = STR_SDCARD_ERROR;
         POPUP_WARNING(STR_SDCARD_ERROR);
         logsClose();
@@ -1088,6 +1088,75 @@ static int luaLcdDrawHudRectangle(lua_State *L)
   return 0;
 }
 
+/*luadoc
+@function lcd.invalidate([x, y, w, h])
+
+Mark a rectangle of the widget zone to be redrawn. The widget refresh()
+function is then called again, and only this rectangle of the screen is
+updated.
+
+@param x,y (positive numbers) top left corner of the rectangle, in the widget zone
+
+@param w,h (positive numbers) width and height of the rectangle
+
+Without parameters, the whole widget zone is redrawn.
+
+@retval boolean false when not called from a widget function
+
+@status current Introduced in 2.4.0
+
+@notice This function only works in widgets.
+*/
+static int luaLcdInvalidate(lua_State * L)
+{
+  bool result;
+  if (lua_gettop(L) == 0) {
+    result = luaWidgetInvalidate(0, 0, -1, -1);
+  }
+  else {
+    coord_t x = luaL_checkinteger(L, 1);
+    coord_t y = luaL_checkinteger(L, 2);
+    coord_t w = luaL_checkinteger(L, 3);
+    coord_t h = luaL_checkinteger(L, 4);
+    result = luaWidgetInvalidate(x, y, w, h);
+  }
+  lua_pushboolean(L, result);
+  return 1;
+}
+
+/*luadoc
+@function lcd.setRefreshSources([source1 [, source2 ...]])
+
+Redraw the widget only when one of these sources changes, or when
+lcd.invalidate() is called, instead of every 100ms.
+
+@param source1... (numbers) up to 8 source identifiers, as returned by
+getSourceIndex() or getFieldInfo()
+
+Without parameters, the widget is only redrawn when lcd.invalidate() is called.
+The background() function of the widget keeps being called when the widget
+is not redrawn, it can call lcd.invalidate() when its state changed.
+
+@retval boolean false when not called from a widget function
+
+@status current Introduced in 2.4.0
+
+@notice This function only works in widgets.
+*/
+static int luaLcdSetRefreshSources(lua_State * L)
+{
+  mixsrc_t sources[LUA_WIDGET_MAX_SOURCES];
+  int count = lua_gettop(L);
+  if (count > LUA_WIDGET_MAX_SOURCES) {
+    return luaL_error(L, "too many sources (max %d)", LUA_WIDGET_MAX_SOURCES);
+  }
+  for (int i = 0; i < count; i++) {
+    sources[i] = luaL_checkunsigned(L, i + 1);
+  }
+  lua_pushboolean(L, luaWidgetSetSources(sources, count));
+  return 1;
+}
+
 const luaL_Reg lcdLib[] = {
   { "refresh", luaLcdRefresh },
   { "clear", luaLcdClear },
@@ -1116,5 +1185,7 @@ const luaL_Reg lcdLib[] = {
   { "drawAnnulus", luaLcdDrawAnnulus },
   { "drawLineWithClipping", luaLcdDrawLineWithClipping },
   { "drawHudRectangle", luaLcdDrawHudRectangle },
+  { "invalidate", luaLcdInvalidate },
+  { "setRefreshSources", luaLcdSetRefreshSources },
   { NULL, NULL }  /* sentinel */
 };
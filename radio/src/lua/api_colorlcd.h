@@ -38,3 +38,8 @@ constexpr int8_t text_vertical_offset[7] {2,2,0,2,3,3,7};
 
 extern bool           luaLcdAllowed;
 extern BitmapBuffer * luaLcdBuffer;
+
+// Dirty regions of the Lua widget which function is running (see widgets.cpp)
+constexpr uint8_t LUA_WIDGET_MAX_SOURCES = 8;
+bool luaWidgetInvalidate(coord_t x, coord_t y, coord_t w, coord_t h);
+bool luaWidgetSetSources(const mixsrc_t * sources, uint8_t count);
@@ -319,9 +319,13 @@ void luaGetValueAndPush(lua_State* L, int src)
 */
 bool luaFindFieldByName(const char * name, LuaField & field, unsigned int flags)
 {
-  // TODO better search method (binary lookup)
-  for (unsigned int n=0; n<DIM(luaSingleFields); ++n) {
-    if (!strcmp(name, luaSingleFields[n].name)) {
+  // luaSingleFields[] is sorted by name when it is generated
+  int first = 0;
+  int last = DIM(luaSingleFields) - 1;
+  while (first <= last) {
+    int n = (first + last) / 2;
+    int cmp = strcmp(name, luaSingleFields[n].name);
+    if (cmp == 0) {
       field.id = luaSingleFields[n].id;
       if (flags & FIND_FIELD_DESC) {
         strncpy(field.desc, luaSingleFields[n].desc, sizeof(field.desc)-1);
@@ -332,38 +336,55 @@ bool luaFindFieldByName(const char * name, LuaField & field, unsigned int flags)
       }
       return true;
     }
+    if (cmp < 0)
+      last = n - 1;
+    else
+      first = n + 1;
   }
 
-  // search in multiples
+  // search in multiples, the name is a prefix followed by one or two digits
+  // and luaMultipleFields[] is sorted by prefix
   unsigned int len = strlen(name);
-  for (unsigned int n=0; n<DIM(luaMultipleFields); ++n) {
-    const char * fieldName = luaMultipleFields[n].name;
-    unsigned int fieldLen = strlen(fieldName);
-    if (!strncmp(name, fieldName, fieldLen)) {
-      unsigned int index;
-      if (len == fieldLen+1 && isdigit(name[fieldLen])) {
-        index = name[fieldLen] - '1';
+  unsigned int prefixLen = len;
+  while (prefixLen > 0 && isdigit(name[prefixLen-1])) {
+    prefixLen--;
+  }
+  if (prefixLen > 0 && (len == prefixLen+1 || len == prefixLen+2)) {
+    first = 0;
+    last = DIM(luaMultipleFields) - 1;
+    while (first <= last) {
+      int n = (first + last) / 2;
+      const char * fieldName = luaMultipleFields[n].name;
+      int cmp = strncmp(name, fieldName, prefixLen);
+      if (cmp == 0 && fieldName[prefixLen] != '\0') {
+        cmp = -1;
       }
-      else if (len == fieldLen+2 && isdigit(name[fieldLen]) && isdigit(name[fieldLen+1])) {
-        index = 10 * (name[fieldLen] - '0') + (name[fieldLen+1] - '1');
-      }
-      else {
-        continue;
-      }
-      if (index < luaMultipleFields[n].count) {
-        if(luaMultipleFields[n].id == MIXSRC_FIRST_TELEM)
-          field.id = luaMultipleFields[n].id + index*3;
+      if (cmp == 0) {
+        unsigned int index;
+        if (len == prefixLen+1)
+          index = name[prefixLen] - '1';
         else
-          field.id = luaMultipleFields[n].id + index;
-        if (flags & FIND_FIELD_DESC) {
-          snprintf(field.desc, sizeof(field.desc)-1, luaMultipleFields[n].desc, index+1);
-          field.desc[sizeof(field.desc)-1] = '\0';
-        }
-        else {
-          field.desc[0] = '\0';
+          index = 10 * (name[prefixLen] - '0') + (name[prefixLen+1] - '1');
+        if (index < luaMultipleFields[n].count) {
+          if (luaMultipleFields[n].id == MIXSRC_FIRST_TELEM)
+            field.id = luaMultipleFields[n].id + index*3;
+          else
+            field.id = luaMultipleFields[n].id + index;
+          if (flags & FIND_FIELD_DESC) {
+            snprintf(field.desc, sizeof(field.desc)-1, luaMultipleFields[n].desc, index+1);
+            field.desc[sizeof(field.desc)-1] = '\0';
+          }
+          else {
+            field.desc[0] = '\0';
+          }
+          return true;
         }
-        return true;
+        break;
       }
+      if (cmp < 0)
+        last = n - 1;
+      else
+        first = n + 1;
     }
   }
 
@@ -442,9 +463,7 @@ static int luaSportTelemetryPop(lua_State * L)
 
   if (luaInputTelemetryFifo->size() >= sizeof(SportTelemetryPacket)) {
     SportTelemetryPacket packet;
-    for (uint8_t i=0; i<sizeof(packet); i++) {
-      luaInputTelemetryFifo->pop(packet.raw[i]);
-    }
+    luaInputTelemetryFifo->popBlock(packet.raw, sizeof(packet));
     lua_pushnumber(L, packet.physicalId);
     lua_pushnumber(L, packet.primId);
     lua_pushnumber(L, packet.dataId);
@@ -774,6 +793,51 @@ static int luaGetFieldInfo(lua_State * L)
   return 0;
 }
 
+// Each Lua state keeps the sources it already looked up by name in a registry
+// table, name -> source id (0 when not found), so that getValue("name") in a loop
+// costs a table lookup. The table is dropped when the telemetry sensors change.
+static const char luaSourcesCacheKey = 0;
+#define SOURCES_CACHE_VERSION  0  // integer key of the cache version, names are strings
+
+static int luaGetSourceByName(lua_State * L, int index)
+{
+  lua_rawgetp(L, LUA_REGISTRYINDEX, &luaSourcesCacheKey);
+  if (lua_istable(L, -1)) {
+    lua_rawgeti(L, -1, SOURCES_CACHE_VERSION);
+    bool valid = (lua_tounsigned(L, -1) == telemetrySensorsVersion);
+    lua_pop(L, 1);
+    if (!valid) {
+      lua_pop(L, 1);
+      lua_pushnil(L);
+    }
+  }
+  if (!lua_istable(L, -1)) {
+    lua_pop(L, 1);
+    lua_newtable(L);
+    lua_pushunsigned(L, telemetrySensorsVersion);
+    lua_rawseti(L, -2, SOURCES_CACHE_VERSION);
+    lua_pushvalue(L, -1);
+    lua_rawsetp(L, LUA_REGISTRYINDEX, &luaSourcesCacheKey);
+  }
+
+  lua_pushvalue(L, index);
+  lua_rawget(L, -2);
+  if (lua_isnumber(L, -1)) {
+    int src = lua_tointeger(L, -1);
+    lua_pop(L, 2);
+    return src;
+  }
+  lua_pop(L, 1);
+
+  LuaField field;
+  int src = luaFindFieldByName(lua_tostring(L, index), field) ? field.id : 0;
+  lua_pushvalue(L, index);
+  lua_pushinteger(L, src);
+  lua_rawset(L, -3);
+  lua_pop(L, 1);
+  return src;
+}
+
 /*luadoc
 @function getValue(source)
 
@@ -832,17 +896,42 @@ static int luaGetValue(lua_State * L)
   }
   else {
     // convert from field name to its id
-    const char *name = luaL_checkstring(L, 1);
-    LuaField field;
-    bool found = luaFindFieldByName(name, field);
-    if (found) {
-      src = field.id;
-    }
+    luaL_checkstring(L, 1);
+    src = luaGetSourceByName(L, 1);
   }
   luaGetValueAndPush(L, src);
   return 1;
 }
 
+/*luadoc
+@function getSourceIndex(source)
+
+Returns the identifier of a source, to be given to getValue() instead of its name.
+Looking a source up by its name has a cost, a script calling getValue() often should
+get the identifiers of its sources once and then use them.
+
+@param source (string) name of the source, see getValue()
+
+@retval number source identifier
+
+@retval nil the source was not found
+
+@notice The identifier of a telemetry sensor changes when the sensor is moved to another
+position in the sensors list.
+
+@status current Introduced in 2.4.0
+*/
+static int luaGetSourceIndex(lua_State * L)
+{
+  luaL_checkstring(L, 1);
+  int src = luaGetSourceByName(L, 1);
+  if (src)
+    lua_pushinteger(L, src);
+  else
+    lua_pushnil(L);
+  return 1;
+}
+
 /*luadoc
 @function getRAS()
 
@@ -1562,11 +1651,13 @@ static int luaLoadScript(lua_State * L)
 /*luadoc
 @function getUsage()
 
-Get percent of already used Lua instructions in current script execution cycle.
+Get percent of the CPU time budget already used by the current script in
+this execution cycle. When a mixer, function or telemetry background script
+reaches 100, its run is suspended and goes on at the next cycle.
 
 @retval usage (number) a value from 0 to 100 (percent)
 
-@status current Introduced in 2.2.1
+@status current Introduced in 2.2.1, CPU time instead of instructions count in 2.4.0
 */
 static int luaGetUsage(lua_State * L)
 {
@@ -1795,6 +1886,7 @@ const luaL_Reg opentxLib[] = {
   { "getGlobalTimer", luaGetGlobalTimer },
   { "getRotEncSpeed", luaGetRotEncSpeed },
   { "getValue", luaGetValue },
+  { "getSourceIndex", luaGetSourceIndex },
   { "getRAS", luaGetRAS },
   { "getTxGPS", luaGetTxGPS },
   { "getFieldInfo", luaGetFieldInfo },
@@ -39,8 +39,10 @@ extern "C" {
   #include <lundump.h>
 }
 
-#define PERMANENT_SCRIPTS_MAX_INSTRUCTIONS (10000/100)
-#define MANUAL_SCRIPTS_MAX_INSTRUCTIONS    (20000/100)
+#define PERMANENT_SCRIPTS_CPU_BUDGET       2000  // us, then the run is suspended until the next cycle
+#define PERMANENT_SCRIPTS_MAX_SLICES       50    // budgets one run may use before the script is killed
+#define MANUAL_SCRIPTS_CPU_BUDGET          10000 // us
+#define LUA_HOOK_INSTRUCTIONS              100   // instructions between two time checks
 #define LUA_WARNING_INFO_LEN               64
 
 lua_State *lsScripts = nullptr;
@@ -53,6 +55,13 @@ ScriptInternalData standaloneScript;
 uint16_t maxLuaInterval = 0;
 uint16_t maxLuaDuration = 0;
 uint8_t instructionsPercent = 0;
+static uint16_t luaCpuBudget;          // us
+static uint16_t luaCpuTimer;           // getTmr2MHz() at the last time check
+static tmr10ms_t luaCpuTimer10ms;      // get_tmr10ms() at the last time check
+static uint32_t luaCpuTime;            // 2MHz timer ticks used by the current run
+static lua_State * luaCpuThread;       // coroutine which may be suspended when out of time
+static lua_State * luaRunner = nullptr;  // coroutine of the next permanent script run
+static int luaRunnerRef;
 char lua_warning_info[LUA_WARNING_INFO_LEN+1];
 struct our_longjmp * global_lj = 0;
 #if defined(COLORLCD)
@@ -92,6 +101,119 @@ void *tracer_alloc(void * ud, void * ptr, size_t osize, size_t nsize)
 
 #endif // #if defined(LUA_ALLOCATOR_TRACER)
 
+LuaStateMemory lsScriptsMemory;
+
+#if LUA_SCRIPT_MEM_MAX > 0
+// Each allocation starts with the index of the script which made it,
+// so that the memory freed by the collector is given back to this script
+union LuaAllocHeader {
+  uint8_t script;
+  double alignDouble;
+  void * alignPointer;
+};
+
+static void * luaAccountingAlloc(void * ud, void * ptr, size_t osize, size_t nsize)
+{
+  LuaStateMemory * memory = (LuaStateMemory *)ud;
+  LuaAllocHeader * header = ptr ? (LuaAllocHeader *)ptr - 1 : nullptr;
+  uint8_t index = header ? header->script : (memory->running ? memory->running->index : 0);
+  LuaScriptMemory * script = index ? memory->scripts[index - 1] : nullptr;
+  size_t realosize = ptr ? osize : 0;  // osize is the object type for new objects
+
+  if (nsize == 0) {
+    if (ptr) {
+      if (script) {
+        script->used -= min<uint32_t>(script->used, osize);
+      }
+      memory->alloc(memory->allocUd, header, osize + sizeof(LuaAllocHeader), 0);
+    }
+    return nullptr;
+  }
+
+  if (script && script == memory->running && script->limit && nsize > realosize && script->used + (nsize - realosize) > script->limit) {
+    // Lua does a full collection and tries again before raising a memory error in the script
+    return nullptr;
+  }
+
+  header = (LuaAllocHeader *)memory->alloc(memory->allocUd, header, ptr ? osize + sizeof(LuaAllocHeader) : osize, nsize + sizeof(LuaAllocHeader));
+  if (!header) {
+    return nullptr;
+  }
+
+  header->script = index;
+  if (nsize > realosize) {
+    memory->allocated += nsize - realosize;
+  }
+  if (script) {
+    if (nsize > realosize)
+      script->used += nsize - realosize;
+    else
+      script->used -= min<uint32_t>(script->used, realosize - nsize);
+  }
+  return header + 1;
+}
+#else
+static void * luaAccountingAlloc(void * ud, void * ptr, size_t osize, size_t nsize)
+{
+  LuaStateMemory * memory = (LuaStateMemory *)ud;
+  size_t realosize = ptr ? osize : 0;  // osize is the object type for new objects
+  if (nsize > realosize) {
+    memory->allocated += nsize - realosize;
+  }
+  return memory->alloc(memory->allocUd, ptr, osize, nsize);
+}
+#endif
+
+lua_State * luaNewState(LuaStateMemory & memory, lua_Alloc alloc, void * ud)
+{
+  memclear(&memory, sizeof(memory));
+  memory.alloc = alloc;
+  memory.allocUd = ud;
+  return lua_newstate(luaAccountingAlloc, &memory);
+}
+
+static LuaStateMemory * luaGetStateMemory(lua_State * L)
+{
+  void * ud;
+  lua_getallocf(L, &ud);
+  return (LuaStateMemory *)ud;
+}
+
+void luaAddScriptMemory(LuaStateMemory & memory, LuaScriptMemory & script, uint32_t limit)
+{
+  script.used = 0;
+  script.limit = limit;
+  script.index = 0;
+
+  for (uint8_t i = 0; i < LUA_MAX_SCRIPTS_MEMORY; i++) {
+    if (memory.scripts[i] == &script) {
+      script.index = i + 1;
+      return;
+    }
+  }
+
+  for (uint8_t i = 0; i < LUA_MAX_SCRIPTS_MEMORY; i++) {
+    if (!memory.scripts[i]) {
+      memory.scripts[i] = &script;
+      script.index = i + 1;
+      return;
+    }
+  }
+
+  TRACE("luaAddScriptMemory(): too many scripts, memory not counted");
+}
+
+void luaRemoveScriptMemory(LuaStateMemory & memory, LuaScriptMemory & script)
+{
+  if (script.index) {
+    memory.scripts[script.index - 1] = nullptr;
+    script.index = 0;
+  }
+  if (memory.running == &script) {
+    memory.running = nullptr;
+  }
+}
+
 /* custom panic handler */
 int custom_lua_atpanic(lua_State * L)
 {
@@ -103,12 +225,39 @@ int custom_lua_atpanic(lua_State * L)
   return 0;
 }
 
+// Adds the time since the last check to luaCpuTime. The 2MHz timer wraps
+// every 32.7ms, so after a long C call (SD card access, bitmap loading...)
+// the number of wraps is found with the 10ms tick
+static void luaUpdateCpuTime()
+{
+  uint16_t now = getTmr2MHz();
+  tmr10ms_t now10ms = get_tmr10ms();
+  uint32_t elapsed = (uint16_t)(now - luaCpuTimer);
+  tmr10ms_t elapsed10ms = now10ms - luaCpuTimer10ms;
+  if (elapsed10ms >= 3) {
+    // the real time is within 10ms of elapsed10ms, that is less than half a wrap
+    int32_t wraps = ((int32_t)(elapsed10ms * 20000) - (int32_t)elapsed + 32768) / 65536;
+    if (wraps > 0) {
+      elapsed += wraps * 65536;
+    }
+  }
+  luaCpuTime += elapsed;
+  luaCpuTimer = now;
+  luaCpuTimer10ms = now10ms;
+}
+
 void luaHook(lua_State * L, lua_Debug *ar)
 {
   if (ar->event == LUA_HOOKCOUNT) {
-    instructionsPercent++;
+    luaUpdateCpuTime();
+    instructionsPercent = min<uint32_t>(255, luaCpuTime * 50 / luaCpuBudget);
+    if (instructionsPercent > 100 && L == luaCpuThread && L->nny == 0) {
+      // out of time, the run goes on at the next cycle (not possible inside a callback from C)
+      lua_yield(L, 0);
+      return;
+    }
 #if defined(DEBUG)
-  // Disable Lua script instructions limit in DEBUG mode,
+  // Disable Lua script CPU limit in DEBUG mode,
   // just report max value reached
   static uint16_t max = 0;
   if (instructionsPercent > 100) {
@@ -144,16 +293,35 @@ void luaHook(lua_State * L, lua_Debug *ar)
 #endif // #if defined(LUA_ALLOCATOR_TRACER)
 }
 
-void luaSetInstructionsLimit(lua_State * L, int count)
+void luaSetCpuBudget(lua_State * L, uint16_t budget, bool yieldable)
 {
   instructionsPercent = 0;
+  luaCpuBudget = budget;
+  luaCpuTime = 0;
+  luaCpuTimer = getTmr2MHz();
+  luaCpuTimer10ms = get_tmr10ms();
+  luaCpuThread = yieldable ? L : nullptr;
 #if defined(LUA_ALLOCATOR_TRACER)
-  lua_sethook(L, luaHook, LUA_MASKCOUNT|LUA_MASKLINE, count);
+  lua_sethook(L, luaHook, LUA_MASKCOUNT|LUA_MASKLINE, LUA_HOOK_INSTRUCTIONS);
 #else
-  lua_sethook(L, luaHook, LUA_MASKCOUNT, count);
+  lua_sethook(L, luaHook, LUA_MASKCOUNT, LUA_HOOK_INSTRUCTIONS);
 #endif
 }
 
+// us used since luaSetCpuBudget()
+static uint32_t luaGetElapsedTime()
+{
+  luaUpdateCpuTime();
+  return luaCpuTime / 2;
+}
+
+void luaResetCpuTime()
+{
+  for (int i=0; i<luaScriptsCount; i++) {
+    scriptInternalData[i].cpuTime = 0;
+  }
+}
+
 int luaGetInputs(lua_State * L, ScriptInputsOutputs & sid)
 {
   if (!lua_istable(L, -1))
@@ -263,6 +431,10 @@ void luaClose(lua_State ** L)
       if (*L == lsScripts) luaDisable();
     }
     UNPROTECT_LUA();
+    if (*L == lsScripts) {
+      // the coroutine of the next permanent script run went with its state
+      luaRunner = nullptr;
+    }
     *L = nullptr;
   }
 }
@@ -276,6 +448,32 @@ void luaRegisterLibraries(lua_State * L)
 }
 
 #define GC_REPORT_TRESHOLD    (2*1024)
+#define GC_TIME_BUDGET        500   // us of collector steps after each Lua task run
+#define GC_STEP_DEBT          1024  // bytes of collector debt paid by each step
+
+// Lua adds what is allocated to the collector debt, and pays it all with one
+// collection step as soon as it is positive, in the middle of a script. After
+// each run the collector is stepped in small steps, within a time budget, until
+// the next run can allocate as much as this one did before the debt is positive.
+static void luaStepGc(lua_State * L)
+{
+  global_State * g = G(L);
+  LuaStateMemory * memory = luaGetStateMemory(L);
+  l_mem target = -(l_mem)memory->allocated;
+  memory->allocated = 0;
+
+  uint16_t start = getTmr2MHz();
+  while (g->GCdebt > target && (uint16_t)(getTmr2MHz() - start) < GC_TIME_BUDGET * 2) {
+    l_mem debt = g->GCdebt;
+    luaE_setdebt(g, GC_STEP_DEBT);
+    luaC_forcestep(L);
+    if (g->gcstate == GCSpause) {
+      // end of the cycle, the debt is now the pause until the next one
+      break;
+    }
+    luaE_setdebt(g, g->GCdebt + debt - GC_STEP_DEBT);
+  }
+}
 
 void luaDoGc(lua_State * L, bool full)
 {
@@ -285,7 +483,7 @@ void luaDoGc(lua_State * L, bool full)
         lua_gc(L, LUA_GCCOLLECT, 0);
       }
       else {
-        lua_gc(L, LUA_GCSTEP, 10);
+        luaStepGc(L);
       }
 #if defined(DEBUG)
       if (L == lsScripts) {
@@ -330,12 +528,17 @@ void luaFree(lua_State * L, ScriptInternalData & sid)
       luaL_unref(L, LUA_REGISTRYINDEX, sid.background);
       sid.background = 0;
     }
+    if (sid.thread) {
+      luaL_unref(L, LUA_REGISTRYINDEX, sid.thread);
+      sid.thread = 0;
+    }
   }
   else {
     luaDisable();
   }
   UNPROTECT_LUA();
 
+  luaRemoveScriptMemory(*luaGetStateMemory(L), sid.memory);
   luaDoGc(L, true);
 }
 
@@ -361,20 +564,305 @@ static int luaDumpWriter(lua_State * L, const void* p, size_t size, void* u)
     1 = remove debug info from bytecode (smaller but errors are less informative)
     0 = keep debug info
 */
-static void luaDumpState(lua_State * L, const char * filename, const FILINFO * finfo, int stripDebug)
+static bool luaDumpState(lua_State * L, const char * filename, const FILINFO * finfo, int stripDebug)
 {
   FIL D;
   if (f_open(&D, filename, FA_WRITE | FA_CREATE_ALWAYS) == FR_OK) {
     lua_lock(L);
-    luaU_dump(L, getproto(L->top - 1), luaDumpWriter, &D, stripDebug);
+    int status = luaU_dump(L, getproto(L->top - 1), luaDumpWriter, &D, stripDebug);
     lua_unlock(L);
-    if (f_close(&D) == FR_OK) {
+    if (f_close(&D) == FR_OK && status == 0) {
       if (finfo != nullptr)
         f_utime(filename, finfo);  // set the file mod time
       TRACE("luaDumpState(%s): Saved bytecode to file.", filename);
+      return true;
     }
   } else
     TRACE_ERROR("luaDumpState(%s): Error: Could not open output file.", filename);
+  return false;
+}
+
+/*
+  Compiled scripts cache
+
+  The scripts directories are read once, recording for each script whether its
+  source and its bytecode exist and their dates. Loading a script then looks it
+  up here instead of stat'ing both files, and the scripts which bytecode is
+  missing or older than their source are compiled while the radio is idle, so
+  that loading a model does not have to compile its scripts.
+
+  Scripts are identified by a hash of their path without extension. A script
+  which is not in the cache (too many scripts, or copied after the directories
+  were read) is simply stat'ed as before.
+*/
+#define LUA_SCRIPTS_CACHE_SIZE   64
+#define LUA_COMPILE_IDLE_DELAY   3  // seconds without any stick or key activity
+
+#define LUA_SCRIPT_HAS_SOURCE    0x01
+#define LUA_SCRIPT_HAS_BINARY    0x02
+#define LUA_SCRIPT_COMPILE_ERROR 0x04
+
+struct LuaScriptsCacheEntry {
+  uint32_t hash;
+  uint32_t sourceTime;  // (fdate << 16) + ftime
+  uint32_t binaryTime;
+  uint8_t flags;
+
+  bool needsCompile() const
+  {
+    return (flags & LUA_SCRIPT_HAS_SOURCE) && !(flags & LUA_SCRIPT_COMPILE_ERROR) &&
+           (!(flags & LUA_SCRIPT_HAS_BINARY) || binaryTime < sourceTime);
+  }
+};
+
+static LuaScriptsCacheEntry luaScriptsCache[LUA_SCRIPTS_CACHE_SIZE];
+static uint8_t luaScriptsCacheCount = 0;
+static bool luaScriptsCacheValid = false;
+static bool luaScriptsToCompile = false;
+
+static const char * const luaScriptsDirectories[] = {
+  SCRIPTS_MIXES_PATH,
+  SCRIPTS_FUNCS_PATH,
+  SCRIPTS_TELEM_PATH,
+  SCRIPTS_TOOLS_PATH,
+  WIZARD_PATH,
+};
+
+static uint32_t luaScriptHash(const char * path, unsigned int len)
+{
+  // FNV-1a, FAT names are case insensitive
+  uint32_t hash = 2166136261u;
+  for (unsigned int i = 0; i < len; i++) {
+    hash = (hash ^ (uint8_t)tolower(path[i])) * 16777619u;
+  }
+  return hash;
+}
+
+static LuaScriptsCacheEntry * luaFindScriptsCacheEntry(uint32_t hash)
+{
+  for (uint8_t i = 0; i < luaScriptsCacheCount; i++) {
+    if (luaScriptsCache[i].hash == hash) {
+      return &luaScriptsCache[i];
+    }
+  }
+  return nullptr;
+}
+
+static inline uint32_t luaFileTime(const FILINFO & fno)
+{
+  return ((uint32_t)fno.fdate << 16) + fno.ftime;
+}
+
+// Calls callback(path, fno) for each file of a scripts directory, with the
+// full path of the file, until it returns false
+static bool luaForEachScriptFile(const char * directory, bool (*callback)(char * path, const FILINFO & fno))
+{
+  char path[LEN_FILE_PATH_MAX + 2 * FF_MAX_LFN + 2];
+  FILINFO fno;
+  DIR dir;
+
+  if (f_opendir(&dir, directory) != FR_OK) {
+    return true;
+  }
+
+  unsigned int pathlen = strlen(directory);
+  memcpy(path, directory, pathlen);
+  path[pathlen++] = '/';
+
+  bool result = true;
+  while (result) {
+    if (f_readdir(&dir, &fno) != FR_OK || fno.fname[0] == '\0') {
+      break;
+    }
+    unsigned int len = strlen(fno.fname);
+    // keep room for the bytecode extension, one char longer
+    if (fno.fname[0] == '.' || (fno.fattrib & AM_DIR) || pathlen + len + 1 >= sizeof(path)) {
+      continue;
+    }
+    memcpy(path + pathlen, fno.fname, len + 1);
+    result = callback(path, fno);
+  }
+
+  f_closedir(&dir);
+  return result;
+}
+
+static bool luaForEachScript(bool (*callback)(char * path, const FILINFO & fno))
+{
+  for (unsigned int i = 0; i < DIM(luaScriptsDirectories); i++) {
+    if (!luaForEachScriptFile(luaScriptsDirectories[i], callback)) {
+      return false;
+    }
+  }
+
+#if defined(COLORLCD)
+  // each widget has its own directory
+  char path[sizeof(WIDGETS_PATH) + FF_MAX_LFN + 1] = WIDGETS_PATH "/";
+  FILINFO fno;
+  DIR dir;
+  bool result = true;
+  if (f_opendir(&dir, WIDGETS_PATH) == FR_OK) {
+    while (result) {
+      if (f_readdir(&dir, &fno) != FR_OK || fno.fname[0] == '\0') {
+        break;
+      }
+      if (fno.fname[0] != '.' && (fno.fattrib & AM_DIR)) {
+        strcpy(path + sizeof(WIDGETS_PATH), fno.fname);
+        result = luaForEachScriptFile(path, callback);
+      }
+    }
+    f_closedir(&dir);
+  }
+  return result;
+#else
+  return true;
+#endif
+}
+
+static bool luaAddScriptsCacheEntry(char * path, const FILINFO & fno)
+{
+  uint8_t extlen;
+  unsigned int len = strlen(path);
+  const char * ext = getFileExtension(path, 0, 0, nullptr, &extlen);
+  uint8_t flag;
+  if (ext && !strcasecmp(ext, SCRIPT_EXT))
+    flag = LUA_SCRIPT_HAS_SOURCE;
+  else if (ext && !strcasecmp(ext, SCRIPT_BIN_EXT))
+    flag = LUA_SCRIPT_HAS_BINARY;
+  else
+    return true;
+
+  uint32_t hash = luaScriptHash(path, len - extlen);
+  LuaScriptsCacheEntry * entry = luaFindScriptsCacheEntry(hash);
+  if (!entry) {
+    if (luaScriptsCacheCount == LUA_SCRIPTS_CACHE_SIZE) {
+      return true;
+    }
+    entry = &luaScriptsCache[luaScriptsCacheCount++];
+    memset(entry, 0, sizeof(LuaScriptsCacheEntry));
+    entry->hash = hash;
+  }
+
+  entry->flags |= flag;
+  if (flag == LUA_SCRIPT_HAS_SOURCE)
+    entry->sourceTime = luaFileTime(fno);
+  else
+    entry->binaryTime = luaFileTime(fno);
+  if (entry->needsCompile()) {
+    luaScriptsToCompile = true;
+  }
+  return true;
+}
+
+static void luaReadScriptsCache()
+{
+  TRACE("luaReadScriptsCache");
+  luaScriptsCacheCount = 0;
+  luaScriptsToCompile = false;
+  luaForEachScript(luaAddScriptsCacheEntry);
+  luaScriptsCacheValid = true;
+}
+
+void luaInvalidateScriptsCache()
+{
+  luaScriptsCacheValid = false;
+}
+
+// Fills the stat results of a script (filename without extension) from the cache
+static bool luaGetScriptsCacheEntry(const char * filename, unsigned int len, FILINFO & fnoLuaS, FRESULT & frLuaS, FILINFO & fnoLuaC, FRESULT & frLuaC)
+{
+  if (!luaScriptsCacheValid) {
+    luaReadScriptsCache();
+  }
+
+  LuaScriptsCacheEntry * entry = luaFindScriptsCacheEntry(luaScriptHash(filename, len));
+  if (!entry) {
+    return false;
+  }
+
+  frLuaS = (entry->flags & LUA_SCRIPT_HAS_SOURCE) ? FR_OK : FR_NO_FILE;
+  fnoLuaS.fdate = entry->sourceTime >> 16;
+  fnoLuaS.ftime = entry->sourceTime & 0xFFFF;
+  frLuaC = (entry->flags & LUA_SCRIPT_HAS_BINARY) ? FR_OK : FR_NO_FILE;
+  fnoLuaC.fdate = entry->binaryTime >> 16;
+  fnoLuaC.ftime = entry->binaryTime & 0xFFFF;
+  return true;
+}
+
+static void luaSetScriptCompiled(const char * filename, unsigned int len, bool compiled)
+{
+  LuaScriptsCacheEntry * entry = luaFindScriptsCacheEntry(luaScriptHash(filename, len));
+  if (entry) {
+    if (compiled) {
+      entry->flags |= LUA_SCRIPT_HAS_BINARY;
+      entry->flags &= ~LUA_SCRIPT_COMPILE_ERROR;
+      entry->binaryTime = entry->sourceTime;
+    }
+    else {
+      entry->flags |= LUA_SCRIPT_COMPILE_ERROR;
+    }
+  }
+}
+
+static bool luaCompileScriptFile(char * path, const FILINFO & fno)
+{
+  uint8_t extlen;
+  unsigned int len = strlen(path);
+  const char * ext = getFileExtension(path, 0, 0, nullptr, &extlen);
+  if (!ext || strcasecmp(ext, SCRIPT_EXT)) {
+    return true;
+  }
+
+  LuaScriptsCacheEntry * entry = luaFindScriptsCacheEntry(luaScriptHash(path, len - extlen));
+  if (!entry || !entry->needsCompile()) {
+    return true;
+  }
+
+  TRACE("luaCompileScriptFile(%s)", path);
+  bool compiled = false;
+  int top = lua_gettop(lsScripts);
+  if (luaL_loadfilex(lsScripts, path, "t") == LUA_OK) {
+    strcpy(path + len - extlen, SCRIPT_BIN_EXT);
+    compiled = luaDumpState(lsScripts, path, &fno, 1);
+  }
+  lua_settop(lsScripts, top);
+  luaSetScriptCompiled(path, len - extlen, compiled);
+
+  // one script at a time
+  return false;
+}
+
+// A compile step blocks the mix scripts and the GUI, it is never done while the model may be flying
+static bool luaModelIsFlying()
+{
+  if (TELEMETRY_STREAMING()) {
+    return true;
+  }
+
+  for (uint8_t i = 0; i < TIMERS; i++) {
+    if (timersStates[i].state == TMR_RUNNING) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void luaCompileNextScript()
+{
+  if (!luaScriptsToCompile || luaState != 0 || !lsScripts || !sdMounted() || inactivity.counter < LUA_COMPILE_IDLE_DELAY || luaModelIsFlying()) {
+    return;
+  }
+
+  if (!luaScriptsCacheValid) {
+    luaReadScriptsCache();
+    return;
+  }
+
+  if (luaForEachScript(luaCompileScriptFile)) {
+    // went through all the scripts without compiling any
+    luaScriptsToCompile = false;
+  }
 }
 #endif  // LUA_COMPILER
 
@@ -447,13 +935,16 @@ int luaLoadScriptFileToState(lua_State * L, const char * filename, const char *
   }
   strncat(filenameFull, filename, fnamelen);
 
-  // check if binary version exists
-  strcpy(filenameFull + fnamelen, SCRIPT_BIN_EXT);
-  frLuaC = f_stat(filenameFull, &fnoLuaC);
+  if (!luaGetScriptsCacheEntry(filenameFull, fnamelen, fnoLuaS, frLuaS, fnoLuaC, frLuaC)) {
+    // check if binary version exists
+    strcpy(filenameFull + fnamelen, SCRIPT_BIN_EXT);
+    frLuaC = f_stat(filenameFull, &fnoLuaC);
 
-  // check if text version exists
+    // check if text version exists
+    strcpy(filenameFull + fnamelen, SCRIPT_EXT);
+    frLuaS = f_stat(filenameFull, &fnoLuaS);
+  }
   strcpy(filenameFull + fnamelen, SCRIPT_EXT);
-  frLuaS = f_stat(filenameFull, &fnoLuaS);
 
   // decide which version to load, text or binary
   if (frLuaC != FR_OK && frLuaS == FR_OK) {
@@ -516,18 +1007,24 @@ int luaLoadScriptFileToState(lua_State * L, const char * filename, const char *
   // we don't pass <mode> on to loadfilex() because we want lua to load whatever file we specify, regardless of content
   lstatus = luaL_loadfilex(L, filenameFull, nullptr);
 #if defined(LUA_COMPILER)
+  if (lstatus == LUA_ERRFILE) {
+    // the scripts cache may be outdated after files were copied or deleted
+    luaInvalidateScriptsCache();
+  }
   // Check for bytecode encoding problem, eg. compiled for x64. Unfortunately Lua doesn't provide a unique error code for this. See Lua/src/lundump.c.
-  if (lstatus == LUA_ERRSYNTAX && loadFileType == 2 && frLuaS == FR_OK && strstr(lua_tostring(L, -1), "precompiled")) {
+  // Also retry with the source when the bytecode is missing.
+  if (loadFileType == 2 && frLuaS == FR_OK && (lstatus == LUA_ERRFILE || (lstatus == LUA_ERRSYNTAX && strstr(lua_tostring(L, -1), "precompiled")))) {
     loadFileType = 1;
     scriptNeedsCompile = true;
     strcpy(filenameFull + fnamelen, SCRIPT_EXT);
     TRACE_ERROR("luaLoadScriptFileToState(%s, %s): Error loading script: %s\n\tRetrying with %s\n", filename, lmode, lua_tostring(L, -1), filenameFull);
+    lua_pop(L, 1);  // error message
     lstatus = luaL_loadfilex(L, filenameFull, nullptr);
   }
   if (lstatus == LUA_OK) {
     if (scriptNeedsCompile && loadFileType == 1) {
       strcpy(filenameFull + fnamelen, SCRIPT_BIN_EXT);
-      luaDumpState(L, filenameFull, &fnoLuaS, (strchr(lmode, 'd') ? 0 : 1));
+      luaSetScriptCompiled(filenameFull, fnamelen, luaDumpState(L, filenameFull, &fnoLuaS, (strchr(lmode, 'd') ? 0 : 1)));
     }
     ret = SCRIPT_OK;
   }
@@ -558,13 +1055,19 @@ static int luaLoad(lua_State * L, const char * filename, ScriptInternalData & si
   int lstatus = 0;
 
   sid.instructions = 0;
+  sid.cpuTime = 0;
   sid.state = SCRIPT_OK;
 
   if (luaState == INTERPRETER_PANIC) {
     return SCRIPT_PANIC;
   }
 
-  luaSetInstructionsLimit(L, MANUAL_SCRIPTS_MAX_INSTRUCTIONS);
+  luaSetCpuBudget(L, MANUAL_SCRIPTS_CPU_BUDGET);
+
+  // stand-alone scripts run alone, they are only limited by LUA_MEM_MAX
+  LuaStateMemory * memory = luaGetStateMemory(L);
+  luaAddScriptMemory(*memory, sid.memory, &sid == &standaloneScript ? 0 : LUA_SCRIPT_MEM_MAX);
+  memory->running = &sid.memory;
 
   PROTECT_LUA() {
     sid.state = luaLoadScriptFileToState(L, filename, LUA_SCRIPT_LOAD_MODE);
@@ -607,11 +1110,14 @@ static int luaLoad(lua_State * L, const char * filename, ScriptInternalData & si
     }
   }
   else {
+    memory->running = nullptr;
     luaDisable();
     return SCRIPT_PANIC;
   }
   UNPROTECT_LUA();
 
+  memory->running = nullptr;
+
   if (sid.state != SCRIPT_OK) {
     luaFree(L, sid);
   }
@@ -872,10 +1378,13 @@ void luaDoOneRunStandalone(event_t evt)
   static uint8_t luaDisplayStatistics = false;
 
   if (standaloneScript.state == SCRIPT_OK && standaloneScript.run) {
-    luaSetInstructionsLimit(lsScripts, MANUAL_SCRIPTS_MAX_INSTRUCTIONS);
+    luaSetCpuBudget(lsScripts, MANUAL_SCRIPTS_CPU_BUDGET);
     lua_rawgeti(lsScripts, LUA_REGISTRYINDEX, standaloneScript.run);
     lua_pushunsigned(lsScripts, evt);
-    if (lua_pcall(lsScripts, 1, 1, 0) == 0) {
+    lsScriptsMemory.running = &standaloneScript.memory;
+    int status = lua_pcall(lsScripts, 1, 1, 0);
+    lsScriptsMemory.running = nullptr;
+    if (status == 0) {
       if (!lua_isnumber(lsScripts, -1)) {
         if (instructionsPercent > 100) {
           TRACE("Script killed");
@@ -947,13 +1456,48 @@ void luaDoOneRunStandalone(event_t evt)
   }
 }
 
+// Permanent scripts run in a coroutine, so that a run which is out of time can
+// be suspended and resumed at the next cycle. The coroutine is kept by the
+// script while its run is suspended, other runs share the same one.
+static lua_State * luaGetRunner()
+{
+  if (!luaRunner) {
+    luaRunner = lua_newthread(lsScripts);
+    luaRunnerRef = luaL_ref(lsScripts, LUA_REGISTRYINDEX);
+  }
+  return luaRunner;
+}
+
+static void luaReleaseThread(lua_State * L, ScriptInternalData & sid)
+{
+  if (sid.thread) {
+    luaL_unref(lsScripts, LUA_REGISTRYINDEX, sid.thread);
+    sid.thread = 0;
+  }
+  else if (L == luaRunner && lua_status(L) != LUA_OK) {
+    // a coroutine can't be run again after an error
+    luaL_unref(lsScripts, LUA_REGISTRYINDEX, luaRunnerRef);
+    luaRunner = nullptr;
+  }
+}
+
 bool luaDoOneRunPermanentScript(event_t evt, int i, uint32_t scriptType)
 {
   ScriptInternalData & sid = scriptInternalData[i];
   if (sid.state != SCRIPT_OK) return false;
 
-  luaSetInstructionsLimit(lsScripts, PERMANENT_SCRIPTS_MAX_INSTRUCTIONS);
+  lua_State * L;
+  if (sid.thread) {
+    lua_rawgeti(lsScripts, LUA_REGISTRYINDEX, sid.thread);
+    L = lua_tothread(lsScripts, -1);
+    lua_pop(lsScripts, 1);
+  }
+  else {
+    L = luaGetRunner();
+  }
+
   int inputsCount = 0;
+  bool yieldable = true;
 #if defined(SIMU) || defined(DEBUG)
   const char *filename;
 #endif
@@ -965,16 +1509,18 @@ bool luaDoOneRunPermanentScript(event_t evt, int i, uint32_t scriptType)
 #endif
     ScriptData & sd = g_model.scriptsData[sid.reference-SCRIPT_MIX_FIRST];
     sio = &scriptInputsOutputs[sid.reference-SCRIPT_MIX_FIRST];
-    inputsCount = sio->inputsCount;
 #if defined(SIMU) || defined(DEBUG)
     filename = sd.file;
 #endif
-    lua_rawgeti(lsScripts, LUA_REGISTRYINDEX, sid.run);
-    for (int j=0; j<sio->inputsCount; j++) {
-      if (sio->inputs[j].type == INPUT_TYPE_SOURCE)
-        luaGetValueAndPush(lsScripts, sd.inputs[j].source);
-      else
-        lua_pushinteger(lsScripts, sd.inputs[j].value + sio->inputs[j].def);
+    if (!sid.thread) {
+      inputsCount = sio->inputsCount;
+      lua_rawgeti(L, LUA_REGISTRYINDEX, sid.run);
+      for (int j=0; j<sio->inputsCount; j++) {
+        if (sio->inputs[j].type == INPUT_TYPE_SOURCE)
+          luaGetValueAndPush(L, sd.inputs[j].source);
+        else
+          lua_pushinteger(L, sd.inputs[j].value + sio->inputs[j].def);
+      }
     }
   }
   else if ((scriptType & RUN_FUNC_SCRIPT) && (sid.reference >= SCRIPT_FUNC_FIRST && sid.reference <= SCRIPT_GFUNC_LAST)) {
@@ -982,10 +1528,12 @@ bool luaDoOneRunPermanentScript(event_t evt, int i, uint32_t scriptType)
 #if defined(SIMU) || defined(DEBUG)
     filename = fn.play.name;
 #endif
-    if (getSwitch(fn.swtch))
-      lua_rawgeti(lsScripts, LUA_REGISTRYINDEX, sid.run);
+    if (sid.thread)
+      ;
+    else if (getSwitch(fn.swtch))
+      lua_rawgeti(L, LUA_REGISTRYINDEX, sid.run);
     else if (sid.background)
-      lua_rawgeti(lsScripts, LUA_REGISTRYINDEX, sid.background);
+      lua_rawgeti(L, LUA_REGISTRYINDEX, sid.background);
     else
       return false;
   }
@@ -996,12 +1544,18 @@ bool luaDoOneRunPermanentScript(event_t evt, int i, uint32_t scriptType)
     filename = script.file;
 #endif
     if ((scriptType & RUN_TELEM_FG_SCRIPT) && (menuHandlers[0]==menuViewTelemetry && sid.reference==SCRIPT_TELEMETRY_FIRST+s_frsky_view)) {
-      lua_rawgeti(lsScripts, LUA_REGISTRYINDEX, sid.run);
-      lua_pushunsigned(lsScripts, evt);
+      // the screen has to be drawn at once, even while a background run is suspended
+      L = lsScripts;
+      yieldable = false;
+      lua_rawgeti(L, LUA_REGISTRYINDEX, sid.run);
+      lua_pushunsigned(L, evt);
       inputsCount = 1;
     }
+    else if ((scriptType & RUN_TELEM_BG_SCRIPT) && sid.thread) {
+      // resume the suspended background run
+    }
     else if ((scriptType & RUN_TELEM_BG_SCRIPT) && (sid.background)) {
-      lua_rawgeti(lsScripts, LUA_REGISTRYINDEX, sid.background);
+      lua_rawgeti(L, LUA_REGISTRYINDEX, sid.background);
     }
     else {
       return false;
@@ -1012,36 +1566,83 @@ bool luaDoOneRunPermanentScript(event_t evt, int i, uint32_t scriptType)
 #endif
   }
 
-  if (lua_pcall(lsScripts, inputsCount, sio ? sio->outputsCount : 0, 0) == 0) {
+  uint16_t budget = (yieldable ? PERMANENT_SCRIPTS_CPU_BUDGET : MANUAL_SCRIPTS_CPU_BUDGET);
+  luaSetCpuBudget(L, budget, yieldable);
+  lsScriptsMemory.running = &sid.memory;
+  int status = (yieldable ? lua_resume(L, lsScripts, inputsCount) : lua_pcall(L, inputsCount, 0, 0));
+  lsScriptsMemory.running = nullptr;
+
+  // the time of a suspended run is summed until its end
+  uint32_t runTime = luaGetElapsedTime();
+  if (yieldable) {
+    sid.runTime += runTime;
+    runTime = sid.runTime;
+  }
+
+  if (status == LUA_YIELD) {
+    if (!sid.thread) {
+      // the runner now belongs to the script until the end of its run
+      sid.thread = luaRunnerRef;
+      luaRunner = nullptr;
+    }
+#if !defined(DEBUG)
+    if (++sid.slices >= PERMANENT_SCRIPTS_MAX_SLICES) {
+      TRACE("Script %8s killed, run not finished after %u us", filename, sid.runTime);
+      sid.state = SCRIPT_KILLED;
+      luaFree(lsScripts, sid);
+    }
+#endif
+    return true;
+  }
+
+  if (status == LUA_OK) {
     if (sio) {
+      lua_settop(L, sio->outputsCount);
       for (int j=sio->outputsCount-1; j>=0; j--) {
-        if (!lua_isnumber(lsScripts, -1)) {
-          sid.state = (instructionsPercent > 100 ? SCRIPT_KILLED : SCRIPT_SYNTAX_ERROR);
+        if (!lua_isnumber(L, -1)) {
+          sid.state = SCRIPT_SYNTAX_ERROR;
           TRACE("Script %8s disabled", filename);
           break;
         }
-        sio->outputs[j].value = lua_tointeger(lsScripts, -1);
-        lua_pop(lsScripts, 1);
+        sio->outputs[j].value = lua_tointeger(L, -1);
+        lua_pop(L, 1);
       }
     }
+    if (yieldable) {
+      lua_settop(L, 0);
+    }
   }
   else {
     if (instructionsPercent > 100) {
       TRACE("Script %8s killed", filename);
       sid.state = SCRIPT_KILLED;
     }
+    else if (status == LUA_ERRMEM) {
+      TRACE("Script %8s killed, memory %u bytes", filename, sid.memory.used);
+      sid.state = SCRIPT_KILLED;
+    }
     else {
-      TRACE("Script %8s error: %s", filename, lua_tostring(lsScripts, -1));
+      TRACE("Script %8s error: %s", filename, lua_tostring(L, -1));
       sid.state = SCRIPT_SYNTAX_ERROR;
     }
   }
 
+  if (yieldable) {
+    luaReleaseThread(L, sid);
+    sid.runTime = 0;
+    sid.slices = 0;
+  }
+
   if (sid.state != SCRIPT_OK) {
     luaFree(lsScripts, sid);
   }
   else {
-    if (instructionsPercent > sid.instructions) {
-      sid.instructions = instructionsPercent;
+    uint32_t percent = runTime * 100 / budget;
+    if (percent > sid.instructions) {
+      sid.instructions = min<uint32_t>(255, percent);
+    }
+    if (runTime > sid.cpuTime) {
+      sid.cpuTime = runTime;
     }
   }
   return true;
@@ -1138,15 +1739,20 @@ void luaInit()
 
   luaClose(&lsScripts);
 
+#if defined(SIMU) && defined(LUA_COMPILER)
+  // scripts may be edited on the computer at any time, read them again
+  luaInvalidateScriptsCache();
+#endif
+
   if (luaState != INTERPRETER_PANIC) {
 #if defined(USE_BIN_ALLOCATOR)
-    lsScripts = lua_newstate(bin_l_alloc, nullptr);   //we use our own allocator!
+    lsScripts = luaNewState(lsScriptsMemory, bin_l_alloc, nullptr);   //we use our own allocator!
 #elif defined(LUA_ALLOCATOR_TRACER)
     memset(&lsScriptsTrace, 0 , sizeof(lsScriptsTrace));
     lsScriptsTrace.script = "lua_newstate(scripts)";
-    lsScripts = lua_newstate(tracer_alloc, &lsScriptsTrace);   //we use tracer allocator
+    lsScripts = luaNewState(lsScriptsMemory, tracer_alloc, &lsScriptsTrace);   //we use tracer allocator
 #else
-    lsScripts = lua_newstate(l_alloc, nullptr);   //we use Lua default allocator
+    lsScripts = luaNewState(lsScriptsMemory, l_alloc, nullptr);   //we use Lua default allocator
 #endif
     if (lsScripts) {
       // install our panic handler
@@ -119,12 +119,41 @@ enum ScriptReference {
   SCRIPT_TELEMETRY_FIRST,
   SCRIPT_TELEMETRY_LAST=SCRIPT_TELEMETRY_FIRST+MAX_SCRIPTS, // telem0 and telem1 .. telem7
 };
+// Memory of one script or widget, counted when LUA_SCRIPT_MEM_MAX > 0
+struct LuaScriptMemory {
+  uint32_t used;
+  uint32_t limit;  // 0 means unlimited
+  uint8_t index;   // in LuaStateMemory::scripts, plus one
+};
+#if defined(COLORLCD)
+  #define LUA_MAX_SCRIPTS_MEMORY  64  // widgets
+#else
+  #define LUA_MAX_SCRIPTS_MEMORY  (MAX_SCRIPTS + 1)
+#endif
+// Memory of a Lua state, see luaNewState()
+struct LuaStateMemory {
+  lua_Alloc alloc;
+  void * allocUd;
+  LuaScriptMemory * running;  // charged with the new allocations
+  uint32_t allocated;  // since the last collector step
+  LuaScriptMemory * scripts[LUA_MAX_SCRIPTS_MEMORY];
+};
+extern LuaStateMemory lsScriptsMemory;
+extern LuaStateMemory lsWidgetsMemory;
+lua_State * luaNewState(LuaStateMemory & memory, lua_Alloc alloc, void * ud);
+void luaAddScriptMemory(LuaStateMemory & memory, LuaScriptMemory & script, uint32_t limit);
+void luaRemoveScriptMemory(LuaStateMemory & memory, LuaScriptMemory & script);
 struct ScriptInternalData {
   uint8_t reference;
   uint8_t state;
   int run;
   int background;
-  uint8_t instructions;
+  int thread;        // coroutine of a run suspended when out of time, resumed at the next cycle
+  uint8_t slices;    // time budgets used by the current run
+  uint8_t instructions;  // max % of the time budget used by one run
+  uint32_t runTime;  // us used by the current run
+  uint32_t cpuTime;  // max us used by one run
+  LuaScriptMemory memory;
 };
 struct ScriptInputsOutputs {
   uint8_t inputsCount;
@@ -150,6 +179,8 @@ void luaError(lua_State * L, uint8_t error, bool acknowledge=true);
 uint32_t luaGetMemUsed(lua_State * L);
 void luaGetValueAndPush(lua_State * L, int src);
 #define luaGetCpuUsed(idx) scriptInternalData[idx].instructions
+#define luaGetCpuTime(idx) scriptInternalData[idx].cpuTime
+void luaResetCpuTime();
 uint8_t isTelemetryScriptAvailable(uint8_t index);
 #define LUA_LOAD_MODEL_SCRIPTS()   luaState |= INTERPRETER_RELOAD_PERMANENT_SCRIPTS
 #define LUA_LOAD_MODEL_SCRIPT(idx) luaState |= INTERPRETER_RELOAD_PERMANENT_SCRIPTS
@@ -184,7 +215,7 @@ bool luaFindFieldByName(const char * name, LuaField & field, unsigned int flags=
 void luaLoadThemes();
 void luaRegisterLibraries(lua_State * L);
 void registerBitmapClass(lua_State * L);
-void luaSetInstructionsLimit(lua_State* L, int count);
+void luaSetCpuBudget(lua_State * L, uint16_t budget, bool yieldable=false);
 int luaLoadScriptFileToState(lua_State * L, const char * filename, const char * mode);
 
 // Unregister LUA widget factories
@@ -198,6 +229,10 @@ void luaUnregisterWidgets();
 
 bool readToolName(char * toolName, const char * filename);
 bool isRadioScriptTool(const char * filename);
+#if defined(LUA_COMPILER)
+void luaInvalidateScriptsCache();
+void luaCompileNextScript();
+#endif
 
 struct LuaMemTracer {
   const char * script;
@@ -27,13 +27,14 @@
 #include "libopenui_file.h"
 #include "api_colorlcd.h"
 
-#define WIDGET_SCRIPTS_MAX_INSTRUCTIONS    (10000/100)
-#define MANUAL_SCRIPTS_MAX_INSTRUCTIONS    (20000/100)
+#define WIDGET_SCRIPTS_CPU_BUDGET          10000 // us, drawing included
+#define MANUAL_SCRIPTS_CPU_BUDGET          10000 // us
 #define LUA_WARNING_INFO_LEN               64
 
 constexpr int LUA_WIDGET_REFRESH = 1000 / 10; // 10 Hz
 
 lua_State * lsWidgets = NULL;
+LuaStateMemory lsWidgetsMemory;
 
 extern int custom_lua_atpanic(lua_State *L);
 
@@ -45,7 +46,7 @@ void exec(int function, int nresults=0)
   if (lsWidgets == 0) return;
 
   if (function) {
-    luaSetInstructionsLimit(lsWidgets, WIDGET_SCRIPTS_MAX_INSTRUCTIONS);
+    luaSetCpuBudget(lsWidgets, WIDGET_SCRIPTS_CPU_BUDGET);
     lua_rawgeti(lsWidgets, LUA_REGISTRYINDEX, function);
     if (lua_pcall(lsWidgets, 0, nresults, 0) != 0) {
       TRACE("Error in theme  %s", lua_tostring(lsWidgets, -1));
@@ -163,18 +164,27 @@ ZoneOption * createOptionsArray(int reference, uint8_t maxOptions)
   return options;
 }
 
+class LuaWidget;
+
+// Widget which Lua function is running, target of lcd.invalidate() and lcd.setRefreshSources()
+static LuaWidget * runningLuaWidget = nullptr;
+
 class LuaWidget: public Widget
 {
+  friend class LuaWidgetFactory;
+
   public:
     LuaWidget(const WidgetFactory * factory, FormGroup * parent, const rect_t & rect, WidgetPersistentData * persistentData, int luaWidgetDataRef):
       Widget(factory, parent, rect, persistentData),
       luaWidgetDataRef(luaWidgetDataRef),
       errorMessage(nullptr)
     {
+      luaAddScriptMemory(lsWidgetsMemory, memory, LUA_SCRIPT_MEM_MAX);
     }
 
     ~LuaWidget() override
     {
+      luaRemoveScriptMemory(lsWidgetsMemory, memory);
       luaL_unref(lsWidgets, LUA_REGISTRYINDEX, luaWidgetDataRef);
       free(errorMessage);
     }
@@ -194,16 +204,53 @@ class LuaWidget: public Widget
     // Calls LUA widget 'refresh' method
     void refresh(BitmapBuffer* dc) override;
 
+    // Adds a rectangle to the area to redraw, w < 0 for the whole zone
+    void addDirtyRect(coord_t x, coord_t y, coord_t w, coord_t h);
+
+    // Redraws the widget only when one of the sources changes or on lcd.invalidate()
+    void setRefreshSources(const mixsrc_t * sources, uint8_t count);
+
   protected:
     int    luaWidgetDataRef;
     char * errorMessage;
     uint32_t lastRefresh = 0;
     bool     refreshed = false;
+    bool     refreshOnDemand = false;
+    uint8_t  sourcesCount = 0;
+    mixsrc_t sources[LUA_WIDGET_MAX_SOURCES];
+    getvalue_t sourcesValues[LUA_WIDGET_MAX_SOURCES];
+    rect_t   dirtyRect = {0, 0, 0, 0};
+    LuaScriptMemory memory;
 
     void checkEvents() override;
+    void setRunning(bool running);
+    bool checkSources();
     void setErrorMessage(const char * funcName);
 };
 
+// The Lua functions of the widget are charged with the memory they allocate
+void LuaWidget::setRunning(bool running)
+{
+  runningLuaWidget = running ? this : nullptr;
+  lsWidgetsMemory.running = running ? &memory : nullptr;
+}
+
+bool luaWidgetInvalidate(coord_t x, coord_t y, coord_t w, coord_t h)
+{
+  if (!runningLuaWidget)
+    return false;
+  runningLuaWidget->addDirtyRect(x, y, w, h);
+  return true;
+}
+
+bool luaWidgetSetSources(const mixsrc_t * sources, uint8_t count)
+{
+  if (!runningLuaWidget)
+    return false;
+  runningLuaWidget->setRefreshSources(sources, count);
+  return true;
+}
+
 void l_pushtableint(const char * key, int value)
 {
   lua_pushstring(lsWidgets, key);
@@ -238,7 +285,7 @@ class LuaWidgetFactory: public WidgetFactory
         initPersistentData(persistentData);
       }
 
-      luaSetInstructionsLimit(lsWidgets, WIDGET_SCRIPTS_MAX_INSTRUCTIONS);
+      luaSetCpuBudget(lsWidgets, WIDGET_SCRIPTS_CPU_BUDGET);
       lua_rawgeti(lsWidgets, LUA_REGISTRYINDEX, createFunction);
 
       lua_newtable(lsWidgets);
@@ -253,11 +300,15 @@ class LuaWidgetFactory: public WidgetFactory
         l_pushtableint(option->name, persistentData->options[i].value.signedValue);
       }
 
+      // the widget exists before create() is called, for lcd.setRefreshSources()
+      LuaWidget * widget = new LuaWidget(this, parent, rect, persistentData, LUA_NOREF);
+      widget->setRunning(true);
       if (lua_pcall(lsWidgets, 2, 1, 0) != 0) {
         TRACE("Error in widget %s create() function: %s", getName(), lua_tostring(lsWidgets, -1));
       }
-      int widgetData = luaL_ref(lsWidgets, LUA_REGISTRYINDEX);
-      return new LuaWidget(this, parent, rect, persistentData, widgetData);
+      widget->setRunning(false);
+      widget->luaWidgetDataRef = luaL_ref(lsWidgets, LUA_REGISTRYINDEX);
+      return widget;
     }
 
   protected:
@@ -281,12 +332,74 @@ void LuaWidget::checkEvents()
   if (now - lastRefresh >= LUA_WIDGET_REFRESH) {
     lastRefresh = now;
     refreshed = false;
-    invalidate();
+    // the focus frame blinks and the fullscreen hint goes away, they need the periodic refresh
+    if (!refreshOnDemand || hasFocus() || fullscreen || checkSources()) {
+      dirtyRect = {0, 0, 0, 0};
+      invalidate();
+    }
 
 #if defined(DEBUG_WINDOWS)
     TRACE_WINDOWS("# refresh: %s", getWindowDebugString().c_str());
 #endif
   }
+
+  // rectangles given to lcd.invalidate()
+  if (dirtyRect.w > 0 && dirtyRect.h > 0) {
+    invalidate(dirtyRect);
+    dirtyRect = {0, 0, 0, 0};
+  }
+}
+
+bool LuaWidget::checkSources()
+{
+  bool changed = false;
+  for (uint8_t i = 0; i < sourcesCount; i++) {
+    getvalue_t value = getValue(sources[i]);
+    if (value != sourcesValues[i]) {
+      sourcesValues[i] = value;
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+void LuaWidget::addDirtyRect(coord_t x, coord_t y, coord_t w, coord_t h)
+{
+  if (w < 0 || h < 0) {
+    x = 0;
+    y = 0;
+    w = width();
+    h = height();
+  }
+
+  // clip to the widget zone
+  coord_t right = min<coord_t>(x + w, width());
+  coord_t bottom = min<coord_t>(y + h, height());
+  x = max<coord_t>(x, 0);
+  y = max<coord_t>(y, 0);
+  if (right <= x || bottom <= y) {
+    return;
+  }
+
+  if (dirtyRect.w > 0 && dirtyRect.h > 0) {
+    right = max<coord_t>(right, dirtyRect.x + dirtyRect.w);
+    bottom = max<coord_t>(bottom, dirtyRect.y + dirtyRect.h);
+    x = min<coord_t>(x, dirtyRect.x);
+    y = min<coord_t>(y, dirtyRect.y);
+  }
+  dirtyRect = {x, y, right - x, bottom - y};
+}
+
+void LuaWidget::setRefreshSources(const mixsrc_t * sources, uint8_t count)
+{
+  refreshOnDemand = true;
+  sourcesCount = min<uint8_t>(count, LUA_WIDGET_MAX_SOURCES);
+  for (uint8_t i = 0; i < sourcesCount; i++) {
+    this->sources[i] = sources[i];
+    sourcesValues[i] = getValue(sources[i]);
+  }
+  // redraw with the values just read
+  addDirtyRect(0, 0, -1, -1);
 }
 
 void LuaWidget::update()
@@ -295,7 +408,7 @@ void LuaWidget::update()
   
   if (lsWidgets == 0 || errorMessage) return;
 
-  luaSetInstructionsLimit(lsWidgets, WIDGET_SCRIPTS_MAX_INSTRUCTIONS);
+  luaSetCpuBudget(lsWidgets, WIDGET_SCRIPTS_CPU_BUDGET);
   LuaWidgetFactory * factory = (LuaWidgetFactory *)this->factory;
   lua_rawgeti(lsWidgets, LUA_REGISTRYINDEX, factory->updateFunction);
   lua_rawgeti(lsWidgets, LUA_REGISTRYINDEX, luaWidgetDataRef);
@@ -306,15 +419,22 @@ void LuaWidget::update()
     l_pushtableint(option->name, persistentData->options[i].value.signedValue);
   }
 
+  setRunning(true);
   if (lua_pcall(lsWidgets, 2, 0, 0) != 0) {
     setErrorMessage("update()");
   }
+  setRunning(false);
+
+  // the options have changed
+  addDirtyRect(0, 0, -1, -1);
 }
 
 void LuaWidget::setErrorMessage(const char * funcName)
 {
   TRACE("Error in widget %s %s function: %s", factory->getName(), funcName, lua_tostring(lsWidgets, -1));
   TRACE("Widget disabled");
+  // "Disabled" has to be drawn
+  refreshOnDemand = false;
   size_t needed = snprintf(NULL, 0, "%s: %s", funcName, lua_tostring(lsWidgets, -1)) + 1;
   errorMessage = (char *)malloc(needed);
   if (errorMessage) {
@@ -337,7 +457,7 @@ void LuaWidget::refresh(BitmapBuffer* dc)
     return;
   }
 
-  luaSetInstructionsLimit(lsWidgets, WIDGET_SCRIPTS_MAX_INSTRUCTIONS);
+  luaSetCpuBudget(lsWidgets, WIDGET_SCRIPTS_CPU_BUDGET);
   LuaWidgetFactory * factory = (LuaWidgetFactory *)this->factory;
   lua_rawgeti(lsWidgets, LUA_REGISTRYINDEX, factory->refreshFunction);
   lua_rawgeti(lsWidgets, LUA_REGISTRYINDEX, luaWidgetDataRef);
@@ -345,9 +465,11 @@ void LuaWidget::refresh(BitmapBuffer* dc)
   // Enable drawing into the current LCD buffer
   luaLcdBuffer = dc;
   luaLcdAllowed = true;
+  setRunning(true);
   if (lua_pcall(lsWidgets, 1, 0, 0) != 0) {
     setErrorMessage("refresh()");
   }
+  setRunning(false);
   // Remove LCD
   luaLcdAllowed = false;
   luaLcdBuffer = nullptr;
@@ -361,14 +483,16 @@ void LuaWidget::background()
   if (lsWidgets == 0 || errorMessage) return;
 
   TRACE("LuaWidget::background()");
-  luaSetInstructionsLimit(lsWidgets, WIDGET_SCRIPTS_MAX_INSTRUCTIONS);
+  luaSetCpuBudget(lsWidgets, WIDGET_SCRIPTS_CPU_BUDGET);
   LuaWidgetFactory * factory = (LuaWidgetFactory *)this->factory;
   if (factory->backgroundFunction) {
     lua_rawgeti(lsWidgets, LUA_REGISTRYINDEX, factory->backgroundFunction);
     lua_rawgeti(lsWidgets, LUA_REGISTRYINDEX, luaWidgetDataRef);
+    setRunning(true);
     if (lua_pcall(lsWidgets, 1, 0, 0) != 0) {
       setErrorMessage("background()");
     }
+    setRunning(false);
   }
 }
 
@@ -426,7 +550,7 @@ void luaLoadFile(const char * filename, void (*callback)())
 
   TRACE("luaLoadFile(%s)", filename);
 
-  luaSetInstructionsLimit(lsWidgets, MANUAL_SCRIPTS_MAX_INSTRUCTIONS);
+  luaSetCpuBudget(lsWidgets, MANUAL_SCRIPTS_CPU_BUDGET);
 
   PROTECT_LUA() {
     if (luaLoadScriptFileToState(lsWidgets, filename, LUA_SCRIPT_LOAD_MODE) == SCRIPT_OK) {
@@ -490,13 +614,13 @@ void luaInitThemesAndWidgets()
   TRACE("luaInitThemesAndWidgets");
 
 #if defined(USE_BIN_ALLOCATOR)
-  lsWidgets = lua_newstate(bin_l_alloc, NULL);   //we use our own allocator!
+  lsWidgets = luaNewState(lsWidgetsMemory, bin_l_alloc, NULL);   //we use our own allocator!
 #elif defined(LUA_ALLOCATOR_TRACER)
   memset(&lsWidgetsTrace, 0 , sizeof(lsWidgetsTrace));
   lsWidgetsTrace.script = "lua_newstate(widgets)";
-  lsWidgets = lua_newstate(tracer_alloc, &lsWidgetsTrace);   //we use tracer allocator
+  lsWidgets = luaNewState(lsWidgetsMemory, tracer_alloc, &lsWidgetsTrace);   //we use tracer allocator
 #else
-  lsWidgets = lua_newstate(l_alloc, NULL);   //we use Lua default allocator
+  lsWidgets = luaNewState(lsWidgetsMemory, l_alloc, NULL);   //we use Lua default allocator
 #endif
   if (lsWidgets) {
     // install our panic handler
@@ -568,6 +568,14 @@ void perMain()
   DEBUG_TIMER_STOP(debugTimerGuiMain);
 #endif
 
+  // the GUI and the Lua scripts have now stored what they edited
+  invalidateEditedCurveTangents();
+
+#if defined(LUA) && defined(LUA_COMPILER)
+  // precompile the scripts while the radio is idle
+  luaCompileNextScript();
+#endif
+
 #if defined(PCBX9E) && !defined(SIMU)
   toplcdRefreshStart();
   setTopFirstTimer(getValue(MIXSRC_FIRST_TIMER+g_model.toplcdTimer));
@@ -638,22 +638,38 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
 
   bitfield_channels_t dirtyChannels = (bitfield_channels_t)-1; // all dirty when mixer starts
 
+  // the first pass walks all mix lines and records where each block of lines of the same channel ends,
+  // the next passes (channels used as sources) then skip the blocks of clean channels at once
+  static uint8_t lastChannelMix[MAX_MIXERS];
+  uint8_t firstChannelMix = 0;
+  uint8_t mixesCount = MAX_MIXERS;
+
   do {
     bitfield_channels_t passDirtyChannels = 0;
 
-    for (uint8_t i=0; i<MAX_MIXERS; i++) {
+    for (uint8_t i=0; i<mixesCount; i++) {
       if (mode == e_perout_mode_normal && pass == 0)
         swOn[i].activeMix = 0;
 
       MixData * md = mixAddress(i);
 
-      if (md->srcRaw == 0)
+      if (md->srcRaw == 0) {
+        mixesCount = i;
         break;
+      }
 
       mixsrc_t stickIndex = md->srcRaw - MIXSRC_Rud;
 
-      if (!(dirtyChannels & ((bitfield_channels_t)1 << md->destCh)))
+      if (pass == 0) {
+        if (i == 0 || md->destCh != (md-1)->destCh)
+          firstChannelMix = i;
+        lastChannelMix[firstChannelMix] = i;
+      }
+      else if (!(dirtyChannels & ((bitfield_channels_t)1 << md->destCh))) {
+        // a clean line is always the first of its block
+        i = lastChannelMix[i];
         continue;
+      }
 
       // if this is the first calculation for the destination channel, initialize it with 0 (otherwise would be random)
       if (i == 0 || md->destCh != (md-1)->destCh)
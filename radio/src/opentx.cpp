@@ -45,6 +45,7 @@ Clipboard clipboard;
 GlobalData globalData;
 
 uint16_t maxMixerDuration; // step = 0.01ms
+MixerTimingStats mixerTimingStats;
 uint8_t heartbeat;
 
 #if defined(OVERRIDE_CHANNEL_FUNCTION)
@@ -484,6 +484,15 @@ const char * sdCopyFile(const char * srcFilename, const char * srcDir, const cha
 }
 #endif // defined(SDCARD)
 
+// called by the drivers each time the card is mounted or unmounted
+void sdMountChanged()
+{
+#if defined(LUA) && defined(LUA_COMPILER)
+  // the scripts may have been changed while the card was out
+  luaInvalidateScriptsCache();
+#endif
+}
+
 
 #if !defined(SIMU) || defined(SIMU_DISKIO)
 uint32_t sdGetNoSectors()
@@ -514,7 +523,14 @@ uint32_t sdGetFreeSectors()
 
 uint32_t sdGetNoSectors()
 {
+#if defined(DISK_CACHE)
+  // the disk cache works on the simulated disk image, when there is one
+  DWORD noSectors = 0;
+  disk_ioctl(0, GET_SECTOR_COUNT, &noSectors);
+  return noSectors;
+#else
   return 0;
+#endif
 }
 
 uint32_t sdGetSize()
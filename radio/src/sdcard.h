@@ -56,6 +56,7 @@
 #if defined(COLORLCD)
 #define RADIO_FILENAME      "radio.bin"
 const char RADIO_MODELSLIST_PATH[] = RADIO_PATH PATH_SEPARATOR "models.txt";
+const char RADIO_MODELSCACHE_PATH[] = RADIO_PATH PATH_SEPARATOR "models.cache";
 const char RADIO_SETTINGS_PATH[] = RADIO_PATH PATH_SEPARATOR RADIO_FILENAME;
 #if defined(SDCARD_YAML)
 const char RADIO_MODELSLIST_YAML_PATH[] = RADIO_PATH PATH_SEPARATOR "models.yml";
@@ -111,6 +112,7 @@ void logsClose();
 void logsWrite();
 
 bool sdCardFormat();
+void sdMountChanged();
 uint32_t sdGetNoSectors();
 uint32_t sdGetSize();
 uint32_t sdGetFreeSectors();
@@ -29,16 +29,11 @@ RlcFile   theFile;  //used for any file operation
 EeFs      eeFs;
 
 blkid_t   freeBlocks = 0;
+blkid_t   freeListTail = 0;
+EepromWriteStats eepromWriteStats;
 
 uint8_t s_sync_write = false;
 
-static uint8_t EeFsRead(blkid_t blk, uint8_t ofs)
-{
-  uint8_t byte;
-  eepromReadBlock(&byte, (size_t)(blk*BS+ofs+BLOCKS_OFFSET), 1);
-  return byte;
-}
-
 static blkid_t EeFsGetLink(blkid_t blk)
 {
   blkid_t ret;
@@ -53,9 +48,9 @@ static void EeFsSetLink(blkid_t blk, blkid_t val)
   eepromWriteBlock((uint8_t *)&s_link, (blk*BS)+BLOCKS_OFFSET, sizeof(blkid_t));
 }
 
-static uint8_t EeFsGetDat(blkid_t blk, uint8_t ofs)
+static void EeFsGetDat(blkid_t blk, uint8_t ofs, uint8_t *buf, uint8_t len)
 {
-  return EeFsRead(blk, ofs+sizeof(blkid_t));
+  eepromReadBlock(buf, (blk*BS)+ofs+sizeof(blkid_t)+BLOCKS_OFFSET, len);
 }
 
 static void EeFsSetDat(blkid_t blk, uint8_t ofs, uint8_t *buf, uint8_t len)
@@ -86,6 +81,35 @@ uint16_t EeFsGetFree()
   return (ret > 0 ? ret : 0);
 }
 
+/// chain blocks blk..last at the end of the free list, blocks are taken
+/// from its head, so that all of them get used in turn (wear levelling)
+static void EeFsAppendFreeList(blkid_t blk, blkid_t last)
+{
+  if (freeListTail) {
+    EeFsSetLink(freeListTail, blk);
+  }
+  else {
+    eeFs.freeList = blk;
+    EeFsFlushFreelist();
+  }
+  freeListTail = last;
+}
+
+/// take the block at the head of the free list, it is still linked to the
+/// next free block, which is the next one to be taken
+static blkid_t EeFsAllocBlock()
+{
+  blkid_t blk = eeFs.freeList;
+  if (blk) {
+    freeBlocks--;
+    eeFs.freeList = EeFsGetLink(blk);
+    if (!eeFs.freeList)
+      freeListTail = 0;
+    eepromWriteStats.blocks++;
+  }
+  return blk;
+}
+
 /// free one or more blocks
 static void EeFsFree(blkid_t blk)
 {
@@ -99,9 +123,7 @@ static void EeFsFree(blkid_t blk)
     freeBlocks++;
   }
 
-  EeFsSetLink(i, eeFs.freeList);
-  eeFs.freeList = blk; //chain in front
-  EeFsFlushFreelist();
+  EeFsAppendFreeList(blk, i);
 }
 
 void eepromCheck()
@@ -113,10 +135,11 @@ void eepromCheck()
   blkid_t blk ;
 
   blkid_t blocksCount;
+  blkid_t lastBlk;
   for (uint8_t i=0; i<=MAXFILES; i++) {
     blocksCount = 0;
     blkid_t blk = (i==MAXFILES ? eeFs.freeList : eeFs.files[i].startBlk);
-    blkid_t lastBlk = 0;
+    lastBlk = 0;
     while (blk) {
       if (blk < FIRSTBLK || // bad blk index
           blk >= BLOCKS  || // bad blk indexchan
@@ -126,6 +149,8 @@ void eepromCheck()
           EeFsSetLink(lastBlk, 0);
         }
         else {
+          if (i == MAXFILES)
+            eeFs.freeList = 0;
           EeFsFlush();
         }
         blk = 0; // abort
@@ -140,10 +165,13 @@ void eepromCheck()
   }
 
   freeBlocks = blocksCount;
+  freeListTail = (eeFs.freeList ? lastBlk : 0);
 
   for (blk=FIRSTBLK; blk<BLOCKS; blk++) {
     if (!bufp[blk]) { // unused block
       freeBlocks++;
+      if (!eeFs.freeList)
+        freeListTail = blk;
       EeFsSetLink(blk, eeFs.freeList);
       eeFs.freeList = blk; // chain in front
       EeFsFlushFreelist();
@@ -173,7 +201,8 @@ void storageFormat()
   }
   EeFsSetLink(BLOCKS-1, 0);
   eeFs.freeList = FIRSTBLK;
-  freeBlocks = BLOCKS;
+  freeListTail = BLOCKS-1;
+  freeBlocks = BLOCKS-FIRSTBLK;
   EeFsFlush();
 
   ENABLE_SYNC_WRITE(false);
@@ -259,12 +288,17 @@ uint8_t EFile::read(uint8_t *buf, uint8_t i_len)
   while (remaining) {
     if (!m_currBlk) break;
 
-    *buf++ = EeFsGetDat(m_currBlk, m_ofs++);
+    // read up to the end of the current block at once
+    uint8_t count = BS-sizeof(blkid_t)-m_ofs;
+    if (count > remaining) count = remaining;
+    EeFsGetDat(m_currBlk, m_ofs, buf, count);
+    buf += count;
+    m_ofs += count;
     if (m_ofs >= BS-sizeof(blkid_t)) {
       m_ofs = 0;
       m_currBlk = EeFsGetLink(m_currBlk);
     }
-    remaining--;
+    remaining -= count;
   }
 
   i_len -= remaining;
@@ -309,12 +343,6 @@ uint16_t RlcFile::readRlc(uint8_t *buf, uint16_t i_len)
   return i;
 }
 
-void RlcFile::write1(uint8_t b)
-{
-  m_write1_byte = b;
-  write(&m_write1_byte, 1);
-}
-
 void RlcFile::write(uint8_t *buf, uint8_t i_len)
 {
   m_write_len = i_len;
@@ -325,23 +353,16 @@ void RlcFile::write(uint8_t *buf, uint8_t i_len)
   } while (IS_SYNC_WRITE_ENABLE() && m_write_len && !s_write_err);
 }
 
+/*
+ * The blocks of the file being written are taken one after the other from
+ * the head of the free list, where they are already chained together: no
+ * link needs to be written until the file is closed. If the radio stops
+ * before, eepromCheck() gives the blocks back to the free list.
+ */
 void RlcFile::nextWriteStep()
 {
   if (!m_currBlk && m_pos==0) {
-    eeFs.files[FILE_TMP].startBlk = m_currBlk = eeFs.freeList;
-    if (m_currBlk) {
-      freeBlocks--;
-      eeFs.freeList = EeFsGetLink(m_currBlk);
-      m_write_step |= WRITE_FIRST_LINK;
-      EeFsFlushFreelist();
-      return;
-    }
-  }
-
-  if ((m_write_step & 0x0f) == WRITE_FIRST_LINK) {
-    m_write_step -= WRITE_FIRST_LINK;
-    EeFsSetLink(m_currBlk, 0);
-    return;
+    eeFs.files[FILE_TMP].startBlk = m_currBlk = EeFsAllocBlock();
   }
 
   while (m_write_len) {
@@ -350,33 +371,18 @@ void RlcFile::nextWriteStep()
       break;
     }
     if (m_ofs >= (BS-sizeof(blkid_t))) {
+      if (!eeFs.freeList) {
+        s_write_err = ERR_FULL;
+        break;
+      }
       m_ofs = 0;
-      blkid_t nextBlk = EeFsGetLink(m_currBlk);
-      if (!nextBlk) {
-        if (!eeFs.freeList) {
-          s_write_err = ERR_FULL;
-          break;
-        }
-        m_write_step += WRITE_NEXT_LINK_1;
-        EeFsSetLink(m_currBlk, eeFs.freeList);
-        // TODO not good
-        return;
+      blkid_t nextBlk = EeFsAllocBlock();
+      if (EeFsGetLink(m_currBlk) != nextBlk) {
+        // the free list has been modified in the meantime
+        EeFsSetLink(m_currBlk, nextBlk);
       }
       m_currBlk = nextBlk;
     }
-    switch (m_write_step & 0x0f) {
-      case WRITE_NEXT_LINK_1:
-        m_currBlk = eeFs.freeList;
-        freeBlocks--;
-        eeFs.freeList = EeFsGetLink(eeFs.freeList);
-        m_write_step += 1;
-        EeFsFlushFreelist();
-        return;
-      case WRITE_NEXT_LINK_2:
-        m_write_step -= WRITE_NEXT_LINK_2;
-        EeFsSetLink(m_currBlk, 0);
-        return;
-    }
     uint8_t tmp = BS-sizeof(blkid_t)-m_ofs; if(tmp>m_write_len) tmp = m_write_len;
     m_write_buf += tmp;
     m_write_len -= tmp;
@@ -390,7 +396,7 @@ void RlcFile::nextWriteStep()
     POPUP_WARNING(STR_EEPROMOVERFLOW);
     m_write_step = 0;
     m_write_len = 0;
-    m_cur_rlc_len = 0;
+    m_encoder.init(nullptr, 0);
   }
   else if (!IS_SYNC_WRITE_ENABLE()) {
     nextRlcWriteStep();
@@ -399,11 +405,19 @@ void RlcFile::nextWriteStep()
 
 void RlcFile::create(uint8_t i_fileId, uint8_t typ, uint8_t sync_write)
 {
+  // the previous contents of FILE_TMP are freed rather than overwritten,
+  // so that successive writes of the same file do not wear the same blocks
+  if (EFile::exists(FILE_TMP)) {
+    EFile::rm(FILE_TMP);
+  }
+
   // all write operations will be executed on FILE_TMP
   openRlc(FILE_TMP); // internal use
   eeFs.files[FILE_TMP].typ      = typ;
   eeFs.files[FILE_TMP].size     = 0;
   m_fileId = i_fileId;
+  m_encoder.init(nullptr, 0);
+  eepromWriteStats.writes++;
   ENABLE_SYNC_WRITE(sync_write);
 }
 
@@ -428,18 +442,7 @@ bool RlcFile::copy(uint8_t i_fileDst, uint8_t i_fileSrc)
     }
   }
 
-  blkid_t fri=0;
-  if (m_currBlk && (fri=EeFsGetLink(m_currBlk)))
-    EeFsSetLink(m_currBlk, 0);
-
-  if (fri) EeFsFree(fri);  //chain in
-
-  eeFs.files[FILE_TMP].size = m_pos;
-  EFile::swap(m_fileId, FILE_TMP);
-
-  assert(!m_write_step);
-
-  // s_sync_write is set to false in swap();
+  close();
   return true;
 }
 
@@ -583,14 +586,7 @@ const char * eeRestoreModel(uint8_t i_fileDst, char *model_name)
     }
   } while (read == 15);
 
-  blkid_t fri=0;
-  if (theFile.m_currBlk && (fri=EeFsGetLink(theFile.m_currBlk)))
-    EeFsSetLink(theFile.m_currBlk, 0);
-
-  if (fri) EeFsFree(fri);  //chain in
-
-  eeFs.files[FILE_TMP].size = theFile.m_pos;
-  EFile::swap(theFile.m_fileId, FILE_TMP); // s_sync_write is set to false in swap();
+  theFile.close();
 
   f_close(&g_oLogFile);
 
@@ -613,86 +609,47 @@ void RlcFile::writeRlc(uint8_t i_fileId, uint8_t typ, uint8_t *buf, uint16_t i_l
   create(i_fileId, typ, sync_write);
 
   m_write_step = WRITE_START_STEP;
-  m_rlc_buf = buf;
-  m_rlc_len = i_len;
-  m_cur_rlc_len = 0;
+  m_encoder.init(buf, i_len);
 
   do {
     nextRlcWriteStep();
   } while (IS_SYNC_WRITE_ENABLE() && m_write_step && !s_write_err);
 }
 
-void RlcFile::nextRlcWriteStep()
+void RlcFile::close()
 {
-  uint8_t cnt    = 1;
-  uint8_t cnt0   = 0;
-  uint16_t i = 0;
-
-  if (m_cur_rlc_len) {
-    uint8_t tmp1 = m_cur_rlc_len;
-    uint8_t *tmp2 = m_rlc_buf;
-    m_rlc_buf += m_cur_rlc_len;
-    m_cur_rlc_len = 0;
-    write(tmp2, tmp1);
-    return;
-  }
+  ENABLE_SYNC_WRITE(true);
 
-  if (m_rlc_len>0) {
+  m_write_step = WRITE_START_STEP;
+  while (m_write_step)
+    nextRlcWriteStep();
 
-    bool run0 = (m_rlc_buf[0] == 0);
+  ENABLE_SYNC_WRITE(false);
+}
 
-    for (i=1; 1; i++) {
-      bool cur0 = (i<m_rlc_len) ? (m_rlc_buf[i] == 0) : false;
-      if (cur0 != run0 || cnt==0x3f || (cnt0 && cnt==0x0f) || i==m_rlc_len) {
-        if (run0) {
-          assert(cnt0==0);
-          if (cnt<8 && i!=m_rlc_len)
-            cnt0 = cnt; //aufbew fuer spaeter
-          else {
-            m_rlc_buf+=cnt;
-            m_rlc_len-=cnt;
-            write1(cnt|0x40);
-            return;
-          }
-        }
-        else {
-          m_rlc_buf+=cnt0;
-          m_rlc_len-=cnt0+cnt;
-          m_cur_rlc_len=cnt;
-          if(cnt0){
-            write1(0x80 | (cnt0<<4) | cnt);
-          }
-          else{
-            write1(cnt);
-          }
-          return;
-        }
-        cnt=0;
-        if (i==m_rlc_len) break;
-        run0 = cur0;
-      }
-      cnt++;
-    }
+void RlcFile::nextRlcWriteStep()
+{
+  if (!m_encoder.isDone()) {
+    // encode what fits in the current block, it is written at once
+    uint8_t len = BS-sizeof(blkid_t);
+    if (m_ofs < len) len -= m_ofs;
+    write(m_rlc_chunk, m_encoder.encode(m_rlc_chunk, len));
+    return;
   }
 
   switch(m_write_step) {
-    case WRITE_START_STEP: {
-      blkid_t fri = 0;
-
-      if (m_currBlk && (fri = EeFsGetLink(m_currBlk))) {
-        // TODO reuse EeFsFree!!!
-        blkid_t prev_freeList = eeFs.freeList;
-        eeFs.freeList = fri;
-        freeBlocks++;
-        while (EeFsGetLink(fri)) {
-          fri = EeFsGetLink(fri);
-          freeBlocks++;
-        }
-        m_write_step = WRITE_FREE_UNUSED_BLOCKS_STEP1;
-        EeFsSetLink(fri, prev_freeList);
+    case WRITE_START_STEP:
+      if (m_currBlk) {
+        // end the file chain, the free list goes on with the next block
+        m_write_step = WRITE_FREE_LIST_STEP;
+        EeFsSetLink(m_currBlk, 0);
         return;
       }
-    }
+
+    case WRITE_FREE_LIST_STEP:
+      m_write_step = WRITE_FINAL_DIRENT_STEP;
+      EeFsFlushFreelist();
+      return;
 
     case WRITE_FINAL_DIRENT_STEP: {
       m_currBlk = eeFs.files[FILE_TMP].startBlk;
@@ -711,16 +668,6 @@ void RlcFile::nextRlcWriteStep()
       m_write_step = 0;
       EeFsFlushDirEnt(FILE_TMP);
       return;
-
-    case WRITE_FREE_UNUSED_BLOCKS_STEP1:
-      m_write_step = WRITE_FREE_UNUSED_BLOCKS_STEP2;
-      EeFsSetLink(m_currBlk, 0);
-      return;
-
-    case WRITE_FREE_UNUSED_BLOCKS_STEP2:
-      m_write_step = WRITE_FINAL_DIRENT_STEP;
-      EeFsFlushFreelist();
-      return;
   }
 }
 
@@ -831,6 +778,32 @@ bool eeModelExists(uint8_t id)
   return EFile::exists(FILE_MODEL(id));
 }
 
+/*
+ * Return true if the file already holds the RLC encoding of buf
+ */
+static bool eeFileIsUpToDate(uint8_t i_fileId, const uint8_t * buf, uint16_t i_len)
+{
+  EFile file;
+  file.openRd(i_fileId);
+
+  RlcEncoder encoder;
+  encoder.init(buf, i_len);
+
+  uint8_t encoded[BS-sizeof(blkid_t)];
+  uint8_t stored[BS-sizeof(blkid_t)];
+  uint16_t size = 0;
+
+  while (!encoder.isDone()) {
+    uint8_t len = encoder.encode(encoded, sizeof(encoded));
+    if (file.read(stored, len) != len || memcmp(encoded, stored, len) != 0) {
+      return false;
+    }
+    size += len;
+  }
+
+  return size == eeFileSize(i_fileId);
+}
+
 void storageCheck(bool immediately)
 {
   if (immediately) {
@@ -838,16 +811,28 @@ void storageCheck(bool immediately)
   }
 
   if (storageDirtyMsk & EE_GENERAL) {
-    TRACE("eeprom write general");
     storageDirtyMsk -= EE_GENERAL;
-    theFile.writeRlc(FILE_GENERAL, FILE_TYP_GENERAL, (uint8_t*)&g_eeGeneral, sizeof(g_eeGeneral), immediately);
-    if (!immediately) return;
+    if (eeFileIsUpToDate(FILE_GENERAL, (uint8_t*)&g_eeGeneral, sizeof(g_eeGeneral))) {
+      TRACE("eeprom general unchanged");
+      eepromWriteStats.skipped++;
+    }
+    else {
+      TRACE("eeprom write general");
+      theFile.writeRlc(FILE_GENERAL, FILE_TYP_GENERAL, (uint8_t*)&g_eeGeneral, sizeof(g_eeGeneral), immediately);
+      if (!immediately) return;
+    }
   }
 
   if (storageDirtyMsk & EE_MODEL) {
-    TRACE("eeprom write model");
     storageDirtyMsk = 0;
-    theFile.writeRlc(FILE_MODEL(g_eeGeneral.currModel), FILE_TYP_MODEL, (uint8_t*)&g_model, sizeof(g_model), immediately);
+    if (eeFileIsUpToDate(FILE_MODEL(g_eeGeneral.currModel), (uint8_t*)&g_model, sizeof(g_model))) {
+      TRACE("eeprom model unchanged");
+      eepromWriteStats.skipped++;
+    }
+    else {
+      TRACE("eeprom write model");
+      theFile.writeRlc(FILE_MODEL(g_eeGeneral.currModel), FILE_TYP_MODEL, (uint8_t*)&g_model, sizeof(g_model), immediately);
+    }
   }
 }
 
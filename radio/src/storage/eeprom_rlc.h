@@ -22,6 +22,7 @@
 #define _EEPROM_RLC_H_
 
 #include "definitions.h"
+#include "rlc.h"
 
   #define blkid_t    uint16_t
   #define EEFS_VERS  5
@@ -47,6 +48,20 @@ PACK(struct EeFs {
 
 extern EeFs eeFs;
 
+struct EepromWriteStats
+{
+  uint16_t writes;  // files written
+  uint16_t skipped; // writes not done because the data was unchanged
+  uint16_t blocks;  // blocks taken from the free list
+
+  void reset()
+  {
+    writes = skipped = blocks = 0;
+  }
+};
+
+extern EepromWriteStats eepromWriteStats;
+
 #define FILE_TYP_GENERAL 1
 #define FILE_TYP_MODEL   2
 
@@ -107,19 +122,13 @@ class RlcFile: public EFile
     uint8_t  m_bRlc;      // control byte for run length decoder
     uint8_t  m_zeroes;
 
-#define WRITE_FIRST_LINK               0x01
-#define WRITE_NEXT_LINK_1              0x02
-#define WRITE_NEXT_LINK_2              0x03
 #define WRITE_START_STEP               0x10
-#define WRITE_FREE_UNUSED_BLOCKS_STEP1 0x20
-#define WRITE_FREE_UNUSED_BLOCKS_STEP2 0x30
+#define WRITE_FREE_LIST_STEP           0x20
 #define WRITE_FINAL_DIRENT_STEP        0x40
 #define WRITE_TMP_DIRENT_STEP          0x50
     uint8_t m_write_step;
-    uint16_t m_rlc_len;
-    uint8_t * m_rlc_buf;
-    uint8_t m_cur_rlc_len;
-    uint8_t m_write1_byte;
+    RlcEncoder m_encoder;
+    uint8_t m_rlc_chunk[BS-sizeof(blkid_t)]; // one block of encoded data
     uint8_t m_write_len;
     uint8_t * m_write_buf;
 
@@ -134,11 +143,13 @@ class RlcFile: public EFile
 
     inline bool isWriting() { return m_write_step != 0; }
     void write(uint8_t *buf, uint8_t i_len);
-    void write1(uint8_t b);
     void nextWriteStep();
     void nextRlcWriteStep();
     void writeRlc(uint8_t i_fileId, uint8_t typ, uint8_t *buf, uint16_t i_len, uint8_t sync_write);
 
+    /// end the file being written and make it the new contents of its fileId
+    void close();
+
     // flush the current write operation if any
     void flush();
 
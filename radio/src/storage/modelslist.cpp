@@ -19,6 +19,7 @@
  */
 
 #include "modelslist.h"
+#include <vector>
 using std::list;
 
 #if defined(SDCARD_YAML)
@@ -177,6 +178,96 @@ bool ModelCell::fetchRfData()
 #endif
 }
 
+#if !defined(SDCARD_YAML)
+// The models cache keeps the name and RF data of each model, along with
+// the size and date of its file, so that only the models changed since
+// the last load have to be read
+#define MODELS_CACHE_VERSION 1
+
+#define FAT_TIMESTAMP(info) (((uint32_t)(info).fdate << 16) | (info).ftime)
+
+PACK(struct ModelsCacheHeader {
+  uint32_t fourcc;
+  uint8_t version;
+  uint8_t eepromVersion;
+  uint16_t entrySize;
+  uint16_t count;
+});
+
+PACK(struct ModelsCacheEntry {
+  char filename[LEN_MODEL_FILENAME];
+  char name[LEN_MODEL_NAME];
+  uint8_t modelId[NUM_MODULES];
+  SimpleModuleData moduleData[NUM_MODULES];
+  uint32_t size;
+  uint16_t date;
+  uint16_t time;
+});
+
+static bool readModelsCache(std::vector<ModelsCacheEntry> & entries)
+{
+  FIL file;
+  if (f_open(&file, RADIO_MODELSCACHE_PATH, FA_OPEN_EXISTING | FA_READ) != FR_OK)
+    return false;
+
+  bool result = false;
+  ModelsCacheHeader header;
+  UINT read;
+  if (f_read(&file, &header, sizeof(header), &read) == FR_OK && read == sizeof(header) &&
+      header.fourcc == OTX_FOURCC && header.version == MODELS_CACHE_VERSION &&
+      header.eepromVersion == EEPROM_VER && header.entrySize == sizeof(ModelsCacheEntry)) {
+    entries.resize(header.count);
+    UINT size = header.count * sizeof(ModelsCacheEntry);
+    result = (f_read(&file, entries.data(), size, &read) == FR_OK && read == size);
+  }
+
+  f_close(&file);
+
+  if (!result)
+    entries.clear();
+
+  return result;
+}
+
+static void writeModelsCache(const std::vector<ModelsCacheEntry> & entries)
+{
+  FIL file;
+  if (f_open(&file, RADIO_MODELSCACHE_PATH, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK)
+    return;
+
+  ModelsCacheHeader header;
+  header.fourcc = OTX_FOURCC;
+  header.version = MODELS_CACHE_VERSION;
+  header.eepromVersion = EEPROM_VER;
+  header.entrySize = sizeof(ModelsCacheEntry);
+  header.count = entries.size();
+
+  UINT written;
+  UINT size = entries.size() * sizeof(ModelsCacheEntry);
+  if (f_write(&file, &header, sizeof(header), &written) != FR_OK || written != sizeof(header) ||
+      f_write(&file, entries.data(), size, &written) != FR_OK || written != size) {
+    f_close(&file);
+    f_unlink(RADIO_MODELSCACHE_PATH);
+    return;
+  }
+
+  f_close(&file);
+}
+
+// the models are usually found in the same order as they were saved
+static const ModelsCacheEntry * findModelsCacheEntry(const std::vector<ModelsCacheEntry> & entries, const char * filename, unsigned & hint)
+{
+  for (unsigned i = 0; i < entries.size(); i++) {
+    unsigned index = (hint + i) % entries.size();
+    if (!strncmp(entries[index].filename, filename, LEN_MODEL_FILENAME)) {
+      hint = index + 1;
+      return &entries[index];
+    }
+  }
+  return nullptr;
+}
+#endif
+
 ModelsCategory::ModelsCategory(const char * name)
 {
   strncpy(this->name, name, sizeof(this->name));
@@ -333,7 +424,6 @@ bool ModelsList::load()
           currentCategory = category;
           currentModel = model;
         }
-        model->fetchRfData();
         modelsCount += 1;
       }
     }
@@ -360,6 +450,10 @@ bool ModelsList::load()
 #endif
 
     f_close(&file);
+
+#if !defined(SDCARD_YAML)
+    fetchRfData();
+#endif
   }
 
   if (!currentModel) {
@@ -377,6 +471,66 @@ bool ModelsList::load()
   return true;
 }
 
+#if !defined(SDCARD_YAML)
+void ModelsList::fetchRfData()
+{
+  std::vector<ModelsCacheEntry> cache;
+  readModelsCache(cache);
+
+  std::vector<ModelsCacheEntry> entries;
+  entries.reserve(modelsCount);
+
+  // FAT dates have a 2s resolution, and are all the same when the RTC is
+  // not set: a model with the date of the cache or a later one may have
+  // changed without its date changing, it is read again
+  FILINFO cacheInfo;
+  uint32_t cacheTimestamp = (f_stat(RADIO_MODELSCACHE_PATH, &cacheInfo) == FR_OK ? FAT_TIMESTAMP(cacheInfo) : 0);
+
+  bool dirty = false;
+  unsigned hint = 0;
+  char path[sizeof(MODELS_PATH) + LEN_MODEL_FILENAME + 1];
+
+  for (auto * category: categories) {
+    for (auto * model: *category) {
+      FILINFO info;
+      getModelPath(path, model->modelFilename);
+      if (f_stat(path, &info) != FR_OK)
+        continue;
+
+      const ModelsCacheEntry * cached = findModelsCacheEntry(cache, model->modelFilename, hint);
+      if (cached && cached->size == info.fsize && cached->date == info.fdate && cached->time == info.ftime &&
+          FAT_TIMESTAMP(info) < cacheTimestamp) {
+        memcpy(model->modelName, cached->name, LEN_MODEL_NAME);
+        model->modelName[LEN_MODEL_NAME] = '\0';
+        memcpy(model->modelId, cached->modelId, sizeof(model->modelId));
+        memcpy(model->moduleData, cached->moduleData, sizeof(model->moduleData));
+        model->valid_rfData = true;
+      }
+      else if (model->fetchRfData()) {
+        dirty = true;
+      }
+      else {
+        continue;
+      }
+
+      ModelsCacheEntry entry;
+      strncpy(entry.filename, model->modelFilename, LEN_MODEL_FILENAME);
+      strncpy(entry.name, model->modelName, LEN_MODEL_NAME);
+      memcpy(entry.modelId, model->modelId, sizeof(entry.modelId));
+      memcpy(entry.moduleData, model->moduleData, sizeof(entry.moduleData));
+      entry.size = info.fsize;
+      entry.date = info.fdate;
+      entry.time = info.ftime;
+      entries.push_back(entry);
+    }
+  }
+
+  if (dirty || entries.size() != cache.size()) {
+    writeModelsCache(entries);
+  }
+}
+#endif
+
 void ModelsList::save()
 {
 #if !defined(SDCARD_YAML)
@@ -94,6 +94,9 @@ class ModelsList
   unsigned int modelsCount;
 
   void init();
+#if !defined(SDCARD_YAML)
+  void fetchRfData();
+#endif
 
 public:
 
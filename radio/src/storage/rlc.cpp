@@ -20,6 +20,7 @@
 
 #include <inttypes.h>
 #include <assert.h>
+#include <string.h>
 #include "debug.h"
 
 #include "rlc.h"
@@ -129,3 +130,66 @@ unsigned int uncompress(uint8_t * dst, unsigned int dstsize, const uint8_t * src
 }
 
 #undef CHECK_DST_SIZE
+
+void RlcEncoder::init(const uint8_t * src, unsigned int srcsize)
+{
+  this->src = src;
+  this->srcsize = srcsize;
+  literals = 0;
+}
+
+uint8_t RlcEncoder::nextToken()
+{
+  bool    run0   = (src[0] == 0);
+  uint8_t cnt    = 1;
+  uint8_t cnt0   = 0;
+
+  for (unsigned int i=1; 1; i++) {
+    bool cur0 = (i < srcsize) ? (src[i] == 0) : false;
+    if (i==srcsize || cur0!=run0 || cnt==0x3f || (cnt0 && cnt==0xf)) {
+      if (run0) {
+        assert(cnt0==0);
+        if (cnt<8 && i!=srcsize) {
+          cnt0 = cnt;
+        }
+        else {
+          src += cnt;
+          srcsize -= cnt;
+          return (cnt | 0x40);
+        }
+      }
+      else {
+        src += cnt0;
+        srcsize -= cnt0;
+        literals = cnt;
+        return cnt0 ? (0x80 | (cnt0<<4) | cnt) : cnt;
+      }
+      cnt = 0;
+      run0 = cur0;
+    }
+    cnt++;
+  }
+}
+
+unsigned int RlcEncoder::encode(uint8_t * dst, unsigned int dstsize)
+{
+  unsigned int len = 0;
+
+  while (len < dstsize && srcsize > 0) {
+    if (literals) {
+      unsigned int count = dstsize - len;
+      if (count > literals)
+        count = literals;
+      memcpy(&dst[len], src, count);
+      src += count;
+      srcsize -= count;
+      literals -= count;
+      len += count;
+    }
+    else {
+      dst[len++] = nextToken();
+    }
+  }
+
+  return len;
+}
@@ -24,4 +24,27 @@
 unsigned int compress(uint8_t * dst, unsigned int dstsize, const uint8_t * src, unsigned int len);
 unsigned int uncompress(uint8_t * dst, unsigned int dstsize, const uint8_t * src, unsigned int len);
 
+// Produces the same stream as compress(), a few bytes at a time, so that
+// the output can go straight to its destination without a full buffer
+class RlcEncoder
+{
+  public:
+    void init(const uint8_t * src, unsigned int srcsize);
+
+    // returns the number of bytes written to dst (0 when done)
+    unsigned int encode(uint8_t * dst, unsigned int dstsize);
+
+    bool isDone() const
+    {
+      return srcsize == 0;
+    }
+
+  protected:
+    const uint8_t * src;
+    unsigned int srcsize;
+    uint8_t literals; // bytes of the current token still to be output
+
+    uint8_t nextToken();
+};
+
 #endif
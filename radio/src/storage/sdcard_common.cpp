@@ -115,9 +115,25 @@ const char * createModel()
 const char * loadModel(const char * filename, bool alarms)
 {
   uint8_t version;
-  preModelLoad();
+  const char * error;
+
+  // the new model is read while the current one is still flying,
+  // pulses and mixer are only stopped while it is swapped in
+  ModelData * model = (ModelData *)malloc(sizeof(ModelData));
+  if (model) {
+    memclear(model, sizeof(ModelData));
+    error = readModel(filename, (uint8_t *)model, sizeof(ModelData), &version);
+    preModelLoad();
+    if (!error) {
+      memcpy(&g_model, model, sizeof(g_model));
+    }
+    free(model);
+  }
+  else {
+    preModelLoad();
+    error = readModel(filename, (uint8_t *)&g_model, sizeof(g_model), &version);
+  }
 
-  const char * error = readModel(filename, (uint8_t *)&g_model, sizeof(g_model), &version);
   if (error) {
     TRACE("loadModel error=%s", error);
 
@@ -28,6 +28,12 @@
 #include "yaml/yaml_parser.h"
 #include "yaml/yaml_datastructs.h"
 
+// Whole sectors are read at once, FatFs then transfers them directly
+// into the buffer instead of going through its own sector window
+#define YAML_READ_BUFFER_SIZE 512
+
+static char yamlReadBuffer[YAML_READ_BUFFER_SIZE];
+
 const char * readYamlFile(const char* fullpath, const YamlParserCalls* calls, void* parser_ctx)
 {
     FIL  file;
@@ -41,14 +47,13 @@ const char * readYamlFile(const char* fullpath, const YamlParserCalls* calls, vo
     YamlParser yp; //TODO: move to re-usable buffer
     yp.init(calls, parser_ctx);
 
-    char buffer[32];
-    while (f_read(&file, buffer, sizeof(buffer), &bytes_read) == FR_OK) {
+    while (f_read(&file, yamlReadBuffer, sizeof(yamlReadBuffer), &bytes_read) == FR_OK) {
 
       // reached EOF?
       if (bytes_read == 0)
         break;
       
-      if (yp.parse(buffer, bytes_read) != YamlParser::CONTINUE_PARSING)
+      if (yp.parse(yamlReadBuffer, bytes_read) != YamlParser::CONTINUE_PARSING)
         break;
     }
 
@@ -101,11 +106,63 @@ static bool yaml_writer(void* opaque, const char* str, size_t len)
     return (ctx->result == FR_OK) && (bytes_written == len);
 }
 
+struct yaml_compare_ctx {
+    FIL* file;
+    bool equal;
+};
+
+static bool yaml_compare(void* opaque, const char* str, size_t len)
+{
+    yaml_compare_ctx* ctx = (yaml_compare_ctx*)opaque;
+
+    char buffer[32];
+    while (len > 0) {
+        UINT chunk = len < sizeof(buffer) ? len : sizeof(buffer);
+        UINT bytes_read;
+        if (f_read(ctx->file, buffer, chunk, &bytes_read) != FR_OK
+            || bytes_read != chunk || memcmp(buffer, str, chunk)) {
+            ctx->equal = false;
+            return false;
+        }
+        str += chunk;
+        len -= chunk;
+    }
+
+    return true;
+}
+
+// Returns true if the file already contains what would be written:
+// saving unchanged data then costs a read instead of a write
+static bool isYamlFileUpToDate(const char* path, const YamlNode* root_node, uint8_t* data)
+{
+    FIL file;
+    if (f_open(&file, path, FA_OPEN_EXISTING | FA_READ) != FR_OK)
+        return false;
+
+    YamlTreeWalker tree;
+    tree.reset(root_node, data);
+
+    yaml_compare_ctx ctx;
+    ctx.file = &file;
+    ctx.equal = true;
+
+    bool result = tree.generate(yaml_compare, &ctx) && ctx.equal
+        && f_tell(&file) == f_size(&file);
+
+    f_close(&file);
+    return result;
+}
+
 const char * writeGeneralSettings()
 {
     // YAML reader
     TRACE("YAML radio settings writer");
 
+    if (isYamlFileUpToDate(RADIO_SETTINGS_YAML_PATH, get_radiodata_nodes(), (uint8_t*)&g_eeGeneral)) {
+        TRACE("YAML radio settings unchanged");
+        return NULL;
+    }
+
     FIL file;
 
     FRESULT result = f_open(&file, RADIO_SETTINGS_YAML_PATH, FA_CREATE_ALWAYS | FA_WRITE);
@@ -150,9 +207,13 @@ const char * readModel(const char * filename, uint8_t * buffer, uint32_t size, u
     // reset GVars to default values
     // Note: taken from opentx.cpp::modelDefault()
     //TODO: new func in gvars
-    for (int p=1; p<MAX_FLIGHT_MODES; p++) {
-        for (int i=0; i<MAX_GVARS; i++) {
-            g_model.flightModeData[p].gvars[i] = GVAR_MAX+1;
+    // (only when a whole model is read, not just its header)
+    if (size == sizeof(ModelData)) {
+        ModelData * model = (ModelData *)buffer;
+        for (int p=1; p<MAX_FLIGHT_MODES; p++) {
+            for (int i=0; i<MAX_GVARS; i++) {
+                model->flightModeData[p].gvars[i] = GVAR_MAX+1;
+            }
         }
     }
     //#endif
@@ -168,6 +229,11 @@ const char * writeModel()
     char path[256];
     getModelPath(path, g_eeGeneral.currModelFilename);
 
+    if (isYamlFileUpToDate(path, get_modeldata_nodes(), (uint8_t*)&g_model)) {
+        TRACE("YAML model unchanged");
+        return NULL;
+    }
+
     FIL file;
 
     FRESULT result = f_open(&file, path, FA_CREATE_ALWAYS | FA_WRITE);
@@ -34,6 +34,12 @@ void storageDirty(uint8_t msk)
   storageDirtyMsk |= msk;
   storageDirtyTime10ms = get_tmr10ms();
 
+  if (msk & EE_MODEL) {
+    // sensors and curves may have been edited
+    invalidateTelemetrySensorsIndex();
+    invalidateCurveTangents();
+  }
+
 #if defined(RTC_BACKUP_RAM)
   rambackupDirtyMsk = storageDirtyMsk;
   rambackupDirtyTime10ms = storageDirtyTime10ms;
@@ -178,6 +184,7 @@ void postModelLoad(bool alarms)
       telemetryItems[i].timeout = TELEMETRY_SENSOR_TIMEOUT_UNAVAILABLE;
     }
   }
+  invalidateTelemetrySensorsIndex();
 
   loadCurves();
 
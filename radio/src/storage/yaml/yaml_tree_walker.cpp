@@ -227,7 +227,23 @@ bool YamlTreeWalker::findNode(const char* tag, uint8_t tag_len)
 {
     if (virt_level)
         return false;
-    
+
+    // Attributes are mostly written in the order they are declared,
+    // so the search first resumes from the last attribute found
+    if (!anon_union) {
+        const struct YamlNode* attr = getAttr();
+        while(attr && attr->type != YDT_NONE) {
+
+            if ((tag_len == attr->tag_len)
+                && !strncmp(tag, attr->tag, tag_len)) {
+                return true; // attribute found!
+            }
+
+            toNextAttr();
+            attr = getAttr();
+        }
+    }
+
     rewind();
 
     const struct YamlNode* attr = getAttr();
@@ -787,8 +787,31 @@ void checkSwitches()
 
 void logicalSwitchesTimerTick()
 {
+  // only timers, sticky, edge and delayed switches have a state to update,
+  // collect them once instead of checking every switch in every flight mode
+  static bool switchTicked[MAX_LOGICAL_SWITCHES];
+  uint8_t tickedSwitches[MAX_LOGICAL_SWITCHES];
+  uint8_t tickedCount = 0;
+  for (uint8_t i=0; i<MAX_LOGICAL_SWITCHES; i++) {
+    LogicalSwitchData * ls = lswAddress(i);
+    bool ticked = (ls->func == LS_FUNC_TIMER || ls->func == LS_FUNC_STICKY || ls->func == LS_FUNC_EDGE || ls->delay || ls->duration);
+    if (ticked) {
+      tickedSwitches[tickedCount++] = i;
+    }
+    else if (switchTicked[i]) {
+      // edited out of the ticked switches, its delay/duration timer would stay stale
+      for (uint8_t fm=0; fm<MAX_FLIGHT_MODES; fm++) {
+        LogicalSwitchContext &context = lswFm[fm].lsw[i];
+        context.timerState = SWITCH_START;
+        context.timer = 0;
+      }
+    }
+    switchTicked[i] = ticked;
+  }
+
   for (uint8_t fm=0; fm<MAX_FLIGHT_MODES; fm++) {
-    for (uint8_t i=0; i<MAX_LOGICAL_SWITCHES; i++) {
+    for (uint8_t n=0; n<tickedCount; n++) {
+      uint8_t i = tickedSwitches[n];
       LogicalSwitchData * ls = lswAddress(i);
       if (ls->func == LS_FUNC_TIMER) {
         int16_t * lastValue = &LS_LAST_VALUE(fm, i);
@@ -52,6 +52,7 @@ extern HardwareOptions hardwareOptions;
 #define MB                             *1024*1024
 #define LUA_MEM_EXTRA_MAX              (2 MB)    // max allowed memory usage for Lua bitmaps (in bytes)
 #define LUA_MEM_MAX                    (6 MB)    // max allowed memory usage for complete Lua  (in bytes), 0 means unlimited
+#define LUA_SCRIPT_MEM_MAX             (1 MB)    // max allowed memory usage for one Lua script or widget (in bytes), 0 means unlimited
 
 // HSI is at 168Mhz (over-drive is not enabled!)
 #define PERI1_FREQUENCY                42000000
@@ -618,6 +619,7 @@ void telemetryPortSetDirectionOutput();
 void sportSendByte(uint8_t byte);
 void sportSendBuffer(const uint8_t * buffer, uint32_t count);
 bool telemetryGetByte(uint8_t * byte);
+uint32_t telemetryGetBytes(uint8_t * buffer, uint32_t count);
 void telemetryClearFifo();
 extern uint32_t telemetryErrors;
 
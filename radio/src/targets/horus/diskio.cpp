@@ -342,7 +342,9 @@ void sdInit()
 void sdMount()
 {
   TRACE("sdMount");
-  
+
+  sdMountChanged();
+
   diskCache.clear();
   
   if (f_mount(&g_FATFS_Obj, "", 1) == FR_OK) {
@@ -383,6 +385,7 @@ void sdDone()
     f_close(&g_bluetoothFile);
 #endif
 
+    sdMountChanged();
     f_mount(nullptr, "", 0); // unmount SD
   }
 }
@@ -45,6 +45,7 @@
 #define MB                              *1024*1024
 #define LUA_MEM_EXTRA_MAX               (2 MB)    // max allowed memory usage for Lua bitmaps (in bytes)
 #define LUA_MEM_MAX                     (6 MB)    // max allowed memory usage for complete Lua  (in bytes), 0 means unlimited
+#define LUA_SCRIPT_MEM_MAX              (1 MB)    // max allowed memory usage for one Lua script or widget (in bytes), 0 means unlimited
 
 // HSI is at 168Mhz (over-drive is not enabled!)
 #define PERI1_FREQUENCY                 42000000
@@ -473,6 +474,7 @@ void telemetryPortSetDirectionOutput();
 void telemetryPortSetDirectionInput();
 void sportSendBuffer(uint8_t * buffer, uint32_t count);
 uint8_t telemetryGetByte(uint8_t * byte);
+uint32_t telemetryGetBytes(uint8_t * buffer, uint32_t count);
 void telemetryClearFifo();
 void sportSendByte(uint8_t byte);
 extern uint32_t telemetryErrors;
@@ -339,7 +339,9 @@ void sdInit()
 void sdMount()
 {
   TRACE("sdMount");
-  
+
+  sdMountChanged();
+
 #if defined(DISK_CACHE)
   diskCache.clear();
 #endif
@@ -369,6 +371,7 @@ void sdDone()
 #if defined(LOG_TELEMETRY)
     f_close(&g_telemetryFile);
 #endif
+    sdMountChanged();
     f_mount(NULL, "", 0); // unmount SD
   }
 }
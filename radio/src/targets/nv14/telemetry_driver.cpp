@@ -209,6 +209,18 @@ uint8_t telemetryGetByte(uint8_t * byte)
 #endif
 }
 
+uint32_t telemetryGetBytes(uint8_t * buffer, uint32_t count)
+{
+#if defined(PCBX12S)
+  if (telemetryFifoMode & TELEMETRY_SERIAL_WITHOUT_DMA)
+    return telemetryNoDMAFifo.popBlock(buffer, count);
+  else
+    return telemetryDMAFifo.popBlock(buffer, count);
+#else
+  return telemetryNoDMAFifo.popBlock(buffer, count);
+#endif
+}
+
 void telemetryClearFifo()
 {
 #if defined(PCBX12S)
@@ -459,6 +459,11 @@ bool telemetryGetByte(uint8_t * byte)
   return false;
 }
 
+uint32_t telemetryGetBytes(uint8_t * buffer, uint32_t count)
+{
+  return 0;
+}
+
 void telemetryClearFifo()
 {
 }
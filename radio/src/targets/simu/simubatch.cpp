@@ -0,0 +1,365 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+/*
+  Headless simulator
+
+  Runs the mixer without any GUI nor real time constraint: each frame is
+  10ms of radio time and frames are computed back to back. The inputs are
+  replayed from a trace file and the channel outputs of every frame can be
+  written to a CSV file, so the same run gives a reference output to diff
+  against after a model or mixer change, and the mixer throughput.
+
+  Trace file, one event per line, "<frame> <input> <value>", # starts a comment:
+    A<n>  analog input n, raw value as returned by anaIn()
+    S<n>  switch n position (-1, 0, 1)
+    K<n>  key n (0 released, 1 pressed)
+    T<n>  trim key n (0 released, 1 pressed)
+    V<n>  telemetry sensor n value, in the unit and precision of the sensor
+*/
+
+#include "opentx.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+struct TraceEvent {
+  uint32_t frame;
+  char input;
+  uint8_t index;
+  int32_t value;
+};
+
+uint16_t analogValues[NUM_ANALOGS] = { 0 };
+
+uint16_t anaIn(uint8_t chan)
+{
+  if (chan < NUM_ANALOGS)
+    return analogValues[chan];
+  else
+    return 0;
+}
+
+uint16_t getAnalogValue(uint8_t index)
+{
+  return anaIn(index);
+}
+
+static int usage(const char * name)
+{
+  fprintf(stderr, "Usage: %s [options] <storage>\n", name);
+#if defined(EEPROM)
+  fprintf(stderr, "  <storage>      EEPROM image\n");
+  fprintf(stderr, "  -m <index>     model index (default: current model)\n");
+#else
+  fprintf(stderr, "  <storage>      SD card directory\n");
+  fprintf(stderr, "  -m <file>      model file name (default: current model)\n");
+#endif
+  fprintf(stderr, "  -i <trace>     input trace to replay\n");
+  fprintf(stderr, "  -o <file>      channel outputs of each frame, CSV, - for stdout\n");
+  fprintf(stderr, "  -n <frames>    number of frames (default: up to the last trace event)\n");
+  fprintf(stderr, "  -c <channels>  number of channels in the outputs (default: %d)\n", MAX_OUTPUT_CHANNELS);
+  return 1;
+}
+
+static bool isValidInput(char input, unsigned index)
+{
+  switch (input) {
+    case 'A':
+      return index < NUM_ANALOGS;
+    case 'S':
+      return index < NUM_SWITCHES;
+    case 'K':
+      return index < NUM_KEYS;
+    case 'T':
+      return index < NUM_TRIMS_KEYS;
+    case 'V':
+      return index < MAX_TELEMETRY_SENSORS;
+    default:
+      return false;
+  }
+}
+
+static bool loadTrace(const char * path, std::vector<TraceEvent> & events)
+{
+  FILE * f = fopen(path, "r");
+  if (!f) {
+    perror(path);
+    return false;
+  }
+
+  char line[256];
+  int lineNumber = 0;
+  bool result = true;
+
+  while (fgets(line, sizeof(line), f)) {
+    lineNumber++;
+
+    char * comment = strchr(line, '#');
+    if (comment) {
+      *comment = '\0';
+    }
+
+    unsigned frame, index;
+    char input;
+    int value;
+    int count = sscanf(line, "%u %c%u %d", &frame, &input, &index, &value);
+    if (count == EOF) {
+      continue;
+    }
+    if (count != 4 || !isValidInput(input, index)) {
+      fprintf(stderr, "%s:%d: invalid event\n", path, lineNumber);
+      result = false;
+      break;
+    }
+
+    TraceEvent event = { frame, input, (uint8_t)index, value };
+    events.push_back(event);
+  }
+
+  fclose(f);
+
+  // events of a same frame keep their file order
+  std::stable_sort(events.begin(), events.end(), [](const TraceEvent & a, const TraceEvent & b) {
+    return a.frame < b.frame;
+  });
+
+  return result;
+}
+
+static void applyEvent(const TraceEvent & event)
+{
+  switch (event.input) {
+    case 'A':
+      analogValues[event.index] = event.value;
+      break;
+    case 'S':
+      simuSetSwitch(event.index, event.value);
+      break;
+    case 'K':
+      simuSetKey(event.index, event.value);
+      break;
+    case 'T':
+      simuSetTrim(event.index, event.value);
+      break;
+    case 'V':
+    {
+      TelemetrySensor & sensor = g_model.telemetrySensors[event.index];
+      telemetryItems[event.index].setValue(sensor, event.value, sensor.unit, sensor.prec);
+      break;
+    }
+  }
+}
+
+static bool loadStorage(const char * path, const char * model)
+{
+#if defined(EEPROM)
+  FILE * f = fopen(path, "rb");
+  if (!f) {
+    perror(path);
+    return false;
+  }
+  // the image is only read into memory, the runs never modify it
+  eeprom = (uint8_t *)malloc(EEPROM_SIZE);
+  memset(eeprom, 0xFF, EEPROM_SIZE);
+  if (fread(eeprom, 1, EEPROM_SIZE, f) == 0) {
+    fprintf(stderr, "%s: empty EEPROM image\n", path);
+    fclose(f);
+    return false;
+  }
+  fclose(f);
+
+  startEepromThread(nullptr);
+
+  if (!storageReadRadioSettings(false)) {
+    fprintf(stderr, "%s: invalid radio settings\n", path);
+    return false;
+  }
+  if (model) {
+    int index = atoi(model);
+    if (index < 0 || index >= MAX_MODELS) {
+      fprintf(stderr, "%s: invalid model index\n", model);
+      return false;
+    }
+    g_eeGeneral.currModel = index;
+  }
+  storageReadCurrentModel();
+#else
+  simuFatfsSetPaths(path, path);
+
+  const char * error = loadRadioSettings();
+  if (error) {
+    fprintf(stderr, "%s: %s\n", path, error);
+    return false;
+  }
+  if (!model) {
+    model = g_eeGeneral.currModelFilename;
+  }
+  error = loadModel(model, false);
+  if (error) {
+    fprintf(stderr, "%s: %s\n", model, error);
+    return false;
+  }
+#endif
+
+  return true;
+}
+
+static void writeHeader(FILE * output, int channels)
+{
+  fprintf(output, "Frame");
+  for (int i = 0; i < channels; i++) {
+    fprintf(output, ",CH%d", i + 1);
+  }
+  fprintf(output, "\n");
+}
+
+static void writeOutputs(FILE * output, uint32_t frame, int channels)
+{
+  fprintf(output, "%u", frame);
+  for (int i = 0; i < channels; i++) {
+    fprintf(output, ",%d", channelOutputs[i]);
+  }
+  fprintf(output, "\n");
+}
+
+int main(int argc, char ** argv)
+{
+  const char * storagePath = nullptr;
+  const char * model = nullptr;
+  const char * tracePath = nullptr;
+  const char * outputPath = nullptr;
+  long frames = -1;
+  int channels = MAX_OUTPUT_CHANNELS;
+
+  for (int i = 1; i < argc; i++) {
+    if (argv[i][0] == '-' && argv[i][1] && !argv[i][2]) {
+      if (i + 1 >= argc) {
+        return usage(argv[0]);
+      }
+      const char * value = argv[i + 1];
+      switch (argv[i++][1]) {
+        case 'm':
+          model = value;
+          break;
+        case 'i':
+          tracePath = value;
+          break;
+        case 'o':
+          outputPath = value;
+          break;
+        case 'n':
+          frames = atol(value);
+          break;
+        case 'c':
+          channels = limit<int>(1, atoi(value), MAX_OUTPUT_CHANNELS);
+          break;
+        default:
+          return usage(argv[0]);
+      }
+    }
+    else if (!storagePath) {
+      storagePath = argv[i];
+    }
+    else {
+      return usage(argv[0]);
+    }
+  }
+
+  if (!storagePath) {
+    return usage(argv[0]);
+  }
+
+  std::vector<TraceEvent> events;
+  if (tracePath && !loadTrace(tracePath, events)) {
+    return 1;
+  }
+  if (frames < 0) {
+    frames = events.empty() ? 1 : events.back().frame + 1;
+  }
+
+  simuInit();
+#if !defined(COLORLCD)
+  menuLevel = 0;
+#endif
+  for (int i = 0; i < NUM_SWITCHES; i++) {
+    simuSetSwitch(i, -1);
+  }
+
+  if (!loadStorage(storagePath, model)) {
+    return 1;
+  }
+
+  // sticks and pots start centered
+  for (int i = 0; i < NUM_STICKS + NUM_POTS + NUM_SLIDERS; i++) {
+    analogValues[i] = g_eeGeneral.calib[i].mid;
+  }
+#if defined(PCBTARANIS)
+  analogValues[TX_RTC_VOLTAGE] = 800;  // 2,34V
+#endif
+
+  FILE * output = nullptr;
+  if (outputPath) {
+    output = strcmp(outputPath, "-") ? fopen(outputPath, "w") : stdout;
+    if (!output) {
+      perror(outputPath);
+      return 1;
+    }
+    writeHeader(output, channels);
+  }
+
+  // see simuStart() about why g_tmr10ms may not start at 0
+  if (g_tmr10ms == 0) {
+    g_tmr10ms = 1;
+  }
+
+  uint64_t start = simuTimerMicros();
+
+  size_t next = 0;
+  for (uint32_t frame = 0; frame < (uint32_t)frames; frame++) {
+    while (next < events.size() && events[next].frame <= frame) {
+      applyEvent(events[next++]);
+    }
+
+    per10ms();
+    doMixerCalculations();
+    doMixerPeriodicUpdates();
+
+    if (output) {
+      writeOutputs(output, frame, channels);
+    }
+  }
+
+  uint64_t duration = simuTimerMicros() - start;
+
+  if (output && output != stdout) {
+    fclose(output);
+  }
+
+  fprintf(stderr, "%ld frames in %.3fs (%.0f frames/s)\n", frames, duration / 1e6, duration ? frames * 1e6 / duration : 0.0);
+
+#if defined(EEPROM)
+  stopEepromThread();
+#endif
+
+  return 0;
+}
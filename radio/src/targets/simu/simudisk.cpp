@@ -18,7 +18,6 @@
  * GNU General Public License for more details.
  */
 
-#if defined(SIMU_DISKIO)
 #include "opentx.h"
 #include "ff.h"
 #include "diskio.h"
@@ -26,7 +25,7 @@
 #include <stdio.h>
 #include <sys/stat.h>
 
-FILE * diskImage = 0;
+#if defined(SIMU_DISKIO)
 FATFS g_FATFS_Obj = {0};
 
 RTOS_MUTEX_HANDLE ioMutex;
@@ -68,6 +67,12 @@ DWORD get_fattime (void)
     | ((uint32_t)t->tm_sec >> 1);
 }
 
+#endif // #if defined(SIMU_DISKIO)
+
+#if defined(SIMU_DISKIO) || defined(DISK_CACHE)
+// the sectors of ./sdcard.image, also used to test the disk cache without FatFs
+FILE * diskImage = 0;
+
 unsigned int noDiskStatus = 0;
 
 void traceDiskStatus()
@@ -82,6 +87,9 @@ DSTATUS disk_initialize (BYTE pdrv)
 {
   traceDiskStatus();
   TRACE_SIMPGMSPACE("disk_initialize(%u)", pdrv);
+  if (diskImage) {
+    fclose(diskImage);
+  }
   diskImage = fopen("sdcard.image", "rb+");
   return diskImage ? (DSTATUS)0 : (DSTATUS)STA_NODISK;
 }
@@ -195,7 +203,9 @@ DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff)
   }
   return RES_OK;
 }
+#endif // #if defined(SIMU_DISKIO) || defined(DISK_CACHE)
 
+#if defined(SIMU_DISKIO)
 void sdInit(void)
 {
   // ioMutex = CoCreateMutex();
@@ -204,6 +214,8 @@ void sdInit(void)
   //   return;
   // }
 
+  sdMountChanged();
+
   if (f_mount(&g_FATFS_Obj, "", 1) == FR_OK) {
     // call sdGetFreeSectors() now because f_getfree() takes a long time first time it's called
     sdGetFreeSectors();
@@ -237,6 +249,7 @@ void sdDone()
 #if defined(LOG_BLUETOOTH)
     f_close(&g_bluetoothFile);
 #endif
+    sdMountChanged();
     f_mount(NULL, "", 0); // unmount SD
   }
 }
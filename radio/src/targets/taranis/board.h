@@ -42,6 +42,7 @@ void rotaryEncoderCheck();
 #define FIRMWARE_ADDRESS                0x08000000
 
 #define LUA_MEM_MAX                     (0)    // max allowed memory usage for complete Lua  (in bytes), 0 means unlimited
+#define LUA_SCRIPT_MEM_MAX              (0)    // max allowed memory usage for one Lua script (in bytes), 0 means unlimited
 
 #if defined(STM32F4)
   #define PERI1_FREQUENCY               42000000
@@ -772,6 +773,7 @@ void sportSendByteLoop(uint8_t byte);
 void sportStopSendByteLoop();
 void sportSendBuffer(const uint8_t * buffer, uint32_t count);
 bool telemetryGetByte(uint8_t * byte);
+uint32_t telemetryGetBytes(uint8_t * buffer, uint32_t count);
 void telemetryClearFifo();
 extern uint32_t telemetryErrors;
 
@@ -1011,6 +1011,9 @@ void sdInit(void)
 void sdMount()
 {
   TRACE("sdMount");
+
+  sdMountChanged();
+
   if (f_mount(&g_FATFS_Obj, "", 1) == FR_OK) {
     // call sdGetFreeSectors() now because f_getfree() takes a long time first time it's called
     sdGetFreeSectors();
@@ -1041,6 +1044,7 @@ void sdDone()
 #if defined(LOG_BLUETOOTH)
     f_close(&g_bluetoothFile);
 #endif
+    sdMountChanged();
     f_mount(nullptr, "", 0); // unmount SD
   }
 }
@@ -144,6 +144,9 @@ TASK_FUNCTION(mixerTask)
   // clear the flag before first loop
   mixerSchedulerClearTrigger();
 
+  uint16_t lastMixerStart = 0;
+  bool lastMixerStartValid = false;
+
   while (true) {
     int timeout = 0;
     for (; timeout < MIXER_MAX_PERIOD; timeout += MIXER_FREQUENT_ACTIONS_PERIOD) {
@@ -184,17 +187,29 @@ TASK_FUNCTION(mixerTask)
     if (!s_pulses_paused) {
       uint16_t t0 = getTmr2MHz();
 
+      if (lastMixerStartValid) {
+        // periods above 32ms wrap around, they only happen without trigger
+        mixerTimingStats.period.add(t0 - lastMixerStart);
+      }
+      lastMixerStart = t0;
+      lastMixerStartValid = true;
+
       DEBUG_TIMER_START(debugTimerMixer);
       RTOS_LOCK_MUTEX(mixerMutex);
 
       doMixerCalculations();
 
+      uint16_t t1 = getTmr2MHz();
+      mixerTimingStats.duration.add(t1 - t0);
+
 #if defined(PCBSKY9X)
       sendSynchronousPulses(1 << EXTERNAL_MODULE);
 #else
       sendSynchronousPulses((1 << INTERNAL_MODULE) | (1 << EXTERNAL_MODULE));
 #endif
 
+      mixerTimingStats.pulses.add(getTmr2MHz() - t1);
+
       doMixerPeriodicUpdates();
 
       DEBUG_TIMER_START(debugTimerMixerCalcToUsage);
@@ -229,6 +244,9 @@ TASK_FUNCTION(mixerTask)
       // - check the cause of timeouts when switching
       //    between protocols with multi-proto RF
     }
+    else {
+      lastMixerStartValid = false;
+    }
   }
 }
 
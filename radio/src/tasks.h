@@ -52,6 +52,43 @@ extern RTOS_MUTEX_HANDLE mixerMutex;
 void stackPaint();
 void tasksStart();
 
+// log2 histogram of mixer task timings, in getTmr2MHz() ticks (0.5us):
+// the first bucket is below 0.256ms, each next one doubles, the last one
+// gets everything from 16.384ms
+constexpr uint8_t MIXER_TIMING_BUCKETS = 8;
+
+struct MixerTimingHistogram
+{
+  uint32_t counts[MIXER_TIMING_BUCKETS];
+  uint16_t max;
+
+  void add(uint16_t value)
+  {
+    uint8_t index = 0;
+    for (uint16_t v = value >> 9; v && index < MIXER_TIMING_BUCKETS - 1; v >>= 1) {
+      index++;
+    }
+    counts[index]++;
+    if (value > max) {
+      max = value;
+    }
+  }
+};
+
+struct MixerTimingStats
+{
+  MixerTimingHistogram period;    // between two mixer runs
+  MixerTimingHistogram duration;  // doMixerCalculations()
+  MixerTimingHistogram pulses;    // sendSynchronousPulses()
+
+  void reset()
+  {
+    memclear(this, sizeof(MixerTimingStats));
+  }
+};
+
+extern MixerTimingStats mixerTimingStats;
+
 extern volatile uint16_t timeForcePowerOffPressed;
 inline void resetForcePowerOffRequest()
 {
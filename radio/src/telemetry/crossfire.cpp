@@ -206,52 +206,59 @@ void processCrossfireTelemetryFrame()
 #if defined(LUA)
     default:
       if (luaInputTelemetryFifo && luaInputTelemetryFifo->hasSpace(telemetryRxBufferCount-2) ) {
-        for (uint8_t i=1; i<telemetryRxBufferCount-1; i++) {
-          // destination address and CRC are skipped
-          luaInputTelemetryFifo->push(telemetryRxBuffer[i]);
-        }
+        // destination address and CRC are skipped
+        luaInputTelemetryFifo->pushBlock(&telemetryRxBuffer[1], telemetryRxBufferCount-2);
       }
       break;
 #endif
   }
 }
 
-void processCrossfireTelemetryData(uint8_t data)
+void processCrossfireTelemetryData(const uint8_t * data, uint32_t length)
 {
 #if defined(AUX_SERIAL)
   if (g_eeGeneral.auxSerialMode == UART_MODE_TELEMETRY_MIRROR) {
-    auxSerialPutc(data);
+    for (uint32_t i = 0; i < length; i++) {
+      auxSerialPutc(data[i]);
+    }
   }
 #endif
 
 #if defined(AUX2_SERIAL)
   if (g_eeGeneral.aux2SerialMode == UART_MODE_TELEMETRY_MIRROR) {
-    aux2SerialPutc(data);
+    for (uint32_t i = 0; i < length; i++) {
+      aux2SerialPutc(data[i]);
+    }
   }
 #endif
 
-  if (telemetryRxBufferCount == 0 && data != RADIO_ADDRESS) {
-    TRACE("[XF] address 0x%02X error", data);
-    return;
-  }
-
-  if (telemetryRxBufferCount == 1 && (data < 2 || data > TELEMETRY_RX_PACKET_SIZE-2)) {
-    TRACE("[XF] length 0x%02X error", data);
-    telemetryRxBufferCount = 0;
-    return;
-  }
+  while (length > 0) {
+    // address and length are checked byte by byte ...
+    if (telemetryRxBufferCount < 2) {
+      uint8_t byte = *data++;
+      length--;
+      if (telemetryRxBufferCount == 0 && byte != RADIO_ADDRESS) {
+        TRACE("[XF] address 0x%02X error", byte);
+        continue;
+      }
+      if (telemetryRxBufferCount == 1 && (byte < 2 || byte > TELEMETRY_RX_PACKET_SIZE-2)) {
+        TRACE("[XF] length 0x%02X error", byte);
+        telemetryRxBufferCount = 0;
+        continue;
+      }
+      telemetryRxBuffer[telemetryRxBufferCount++] = byte;
+      continue;
+    }
 
-  if (telemetryRxBufferCount < TELEMETRY_RX_PACKET_SIZE) {
-    telemetryRxBuffer[telemetryRxBufferCount++] = data;
-  }
-  else {
-    TRACE("[XF] array size %d error", telemetryRxBufferCount);
-    telemetryRxBufferCount = 0;
-  }
+    // ... then the rest of the frame is copied at once
+    uint8_t frameLength = telemetryRxBuffer[1] + 2;
+    uint32_t count = min<uint32_t>(frameLength - telemetryRxBufferCount, length);
+    memcpy(&telemetryRxBuffer[telemetryRxBufferCount], data, count);
+    telemetryRxBufferCount += count;
+    data += count;
+    length -= count;
 
-  if (telemetryRxBufferCount > 4) {
-    uint8_t length = telemetryRxBuffer[1];
-    if (length + 2 == telemetryRxBufferCount) {
+    if (telemetryRxBufferCount == frameLength) {
 #if defined(BLUETOOTH)
       if (g_eeGeneral.bluetoothMode == BLUETOOTH_TELEMETRY && bluetooth.state == BLUETOOTH_STATE_CONNECTED) {
         bluetooth.write(telemetryRxBuffer, telemetryRxBufferCount);
@@ -263,6 +270,11 @@ void processCrossfireTelemetryData(uint8_t data)
   }
 }
 
+void processCrossfireTelemetryData(uint8_t data)
+{
+  processCrossfireTelemetryData(&data, 1);
+}
+
 void crossfireSetDefault(int index, uint8_t id, uint8_t subId)
 {
   TelemetrySensor & telemetrySensor = g_model.telemetrySensors[index];
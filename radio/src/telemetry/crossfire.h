@@ -91,6 +91,7 @@ enum CrossfireFrames{
 };
 
 void processCrossfireTelemetryData(uint8_t data);
+void processCrossfireTelemetryData(const uint8_t * data, uint32_t length);
 void crossfireSetDefault(int index, uint8_t id, uint8_t subId);
 uint8_t createCrossfireModelIDFrame(uint8_t * frame);
 
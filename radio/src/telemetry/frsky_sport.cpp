@@ -331,9 +331,7 @@ void sportProcessTelemetryPacketWithoutCrc(uint8_t origin, const uint8_t * packe
             luaPacket.primId = primId;
             luaPacket.dataId = dataId;
             luaPacket.value = data;
-            for (uint8_t i=0; i<sizeof(SportTelemetryPacket); i++) {
-              luaInputTelemetryFifo->push(luaPacket.raw[i]);
-            }
+            luaInputTelemetryFifo->pushBlock(luaPacket.raw, sizeof(SportTelemetryPacket));
           }
 #endif
         }
@@ -366,9 +364,7 @@ void sportProcessTelemetryPacketWithoutCrc(uint8_t origin, const uint8_t * packe
       luaPacket.primId = primId;
       luaPacket.dataId = dataId;
       luaPacket.value = data;
-      for (uint8_t i=0; i<sizeof(SportTelemetryPacket); i++) {
-        luaInputTelemetryFifo->push(luaPacket.raw[i]);
-      }
+      luaInputTelemetryFifo->pushBlock(luaPacket.raw, sizeof(SportTelemetryPacket));
     }
   }
 #endif
@@ -82,6 +82,20 @@ void processTelemetryData(uint8_t data)
   processFrskyTelemetryData(data);
 }
 
+void processTelemetryData(const uint8_t * data, uint32_t length)
+{
+#if defined(CROSSFIRE)
+  if (telemetryProtocol == PROTOCOL_TELEMETRY_CROSSFIRE) {
+    processCrossfireTelemetryData(data, length);
+    return;
+  }
+#endif
+
+  for (uint32_t i = 0; i < length; i++) {
+    processTelemetryData(data[i]);
+  }
+}
+
 inline bool isBadAntennaDetected()
 {
   if (!isRasValueValid())
@@ -140,12 +154,16 @@ void telemetryWakeup()
 #endif
 
 #if defined(STM32)
-  if (telemetryGetByte(&data)) {
+  uint8_t buffer[TELEMETRY_RX_CHUNK_SIZE];
+  uint32_t count = telemetryGetBytes(buffer, sizeof(buffer));
+  if (count > 0) {
     LOG_TELEMETRY_WRITE_START();
     do {
-      processTelemetryData(data);
-      LOG_TELEMETRY_WRITE_BYTE(data);
-    } while (telemetryGetByte(&data));
+      processTelemetryData(buffer, count);
+      for (uint32_t i = 0; i < count; i++) {
+        LOG_TELEMETRY_WRITE_BYTE(buffer[i]);
+      }
+    } while ((count = telemetryGetBytes(buffer, sizeof(buffer))) > 0);
   }
 #elif defined(PCBSKY9X)
   if (telemetryProtocol == PROTOCOL_TELEMETRY_FRSKY_D_SECONDARY) {
@@ -475,6 +475,53 @@ void TelemetryItem::eval(const TelemetrySensor & sensor)
   }
 }
 
+// (id, subId) hash chains of the custom sensors, so that each received value
+// does not have to walk all the sensors. Chains are kept in increasing index
+// order, the instance is checked on each candidate as it may be ignored.
+constexpr uint8_t TELEMETRY_SENSORS_INDEX_SIZE = 32;
+constexpr uint8_t TELEMETRY_SENSORS_INDEX_END = 0xFF;
+
+static uint8_t telemetrySensorsIndexHead[TELEMETRY_SENSORS_INDEX_SIZE];
+static uint8_t telemetrySensorsIndexNext[MAX_TELEMETRY_SENSORS];
+static bool telemetrySensorsIndexValid = false;
+uint16_t telemetrySensorsVersion = 0;
+
+static inline uint8_t telemetrySensorsIndexHash(uint16_t id, uint8_t subId)
+{
+  return (id ^ (id >> 5) ^ (id >> 10) ^ subId) & (TELEMETRY_SENSORS_INDEX_SIZE - 1);
+}
+
+void invalidateTelemetrySensorsIndex()
+{
+  telemetrySensorsIndexValid = false;
+  telemetrySensorsVersion++;
+}
+
+static void buildTelemetrySensorsIndex()
+{
+  memset(telemetrySensorsIndexHead, TELEMETRY_SENSORS_INDEX_END, sizeof(telemetrySensorsIndexHead));
+  for (int index = MAX_TELEMETRY_SENSORS - 1; index >= 0; index--) {
+    TelemetrySensor & telemetrySensor = g_model.telemetrySensors[index];
+    if (telemetrySensor.type == TELEM_TYPE_CUSTOM) {
+      uint8_t hash = telemetrySensorsIndexHash(telemetrySensor.id, telemetrySensor.subId);
+      telemetrySensorsIndexNext[index] = telemetrySensorsIndexHead[hash];
+      telemetrySensorsIndexHead[hash] = index;
+    }
+    else {
+      telemetrySensorsIndexNext[index] = TELEMETRY_SENSORS_INDEX_END;
+    }
+  }
+  telemetrySensorsIndexValid = true;
+}
+
+static inline bool isTelemetrySensorMatching(TelemetrySensor & telemetrySensor, TelemetryProtocol protocol, uint16_t id, uint8_t subId, uint8_t instance)
+{
+  return telemetrySensor.type == TELEM_TYPE_CUSTOM && telemetrySensor.id == id &&
+         telemetrySensor.subId == subId &&
+         (telemetrySensor.isSameInstance(protocol, instance) ||
+          g_model.ignoreSensorIds);
+}
+
 void delTelemetryIndex(uint8_t index)
 {
   memclear(&g_model.telemetrySensors[index], sizeof(TelemetrySensor));
@@ -509,19 +556,35 @@ int setTelemetryValue(TelemetryProtocol protocol, uint16_t id, uint8_t subId, ui
 {
   bool sensorFound = false;
 
-  for (int index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
-    TelemetrySensor &telemetrySensor = g_model.telemetrySensors[index];
+  if (!telemetrySensorsIndexValid) {
+    buildTelemetrySensorsIndex();
+  }
 
-    if (telemetrySensor.type == TELEM_TYPE_CUSTOM && telemetrySensor.id == id &&
-        telemetrySensor.subId == subId &&
-        (telemetrySensor.isSameInstance(protocol, instance) ||
-         g_model.ignoreSensorIds)) {
+  uint8_t candidate = telemetrySensorsIndexHead[telemetrySensorsIndexHash(id, subId)];
+  while (candidate < MAX_TELEMETRY_SENSORS) {
+    TelemetrySensor &telemetrySensor = g_model.telemetrySensors[candidate];
 
-      telemetryItems[index].setValue(telemetrySensor, value, unit, prec);
+    if (isTelemetrySensorMatching(telemetrySensor, protocol, id, subId, instance)) {
+      telemetryItems[candidate].setValue(telemetrySensor, value, unit, prec);
       sensorFound = true;
       // we continue search here, because sensors can share the same id and
       // instance
     }
+
+    candidate = telemetrySensorsIndexNext[candidate];
+  }
+
+  if (!sensorFound) {
+    // the index may be late after a sensor was changed, check all of them
+    // before creating a new one
+    for (int index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
+      TelemetrySensor &telemetrySensor = g_model.telemetrySensors[index];
+      if (isTelemetrySensorMatching(telemetrySensor, protocol, id, subId, instance)) {
+        telemetryItems[index].setValue(telemetrySensor, value, unit, prec);
+        sensorFound = true;
+        telemetrySensorsIndexValid = false;
+      }
+    }
   }
 
   if (sensorFound || !allowNewSensors) {
@@ -530,6 +593,7 @@ int setTelemetryValue(TelemetryProtocol protocol, uint16_t id, uint8_t subId, ui
 
   int index = availableTelemetryIndex();
   if (index >= 0) {
+    telemetrySensorsIndexValid = false;
     switch (protocol) {
       case PROTOCOL_TELEMETRY_FRSKY_SPORT:
         frskySportSetDefault(index, id, subId, instance);
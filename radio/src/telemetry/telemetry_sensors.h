@@ -135,5 +135,8 @@ class TelemetryItem
 extern TelemetryItem telemetryItems[MAX_TELEMETRY_SENSORS];
 extern uint8_t allowNewSensors;
 bool isFaiForbidden(source_t idx);
+void invalidateTelemetrySensorsIndex();
+// incremented each time the sensors may have changed, for the caches of sensors by name
+extern uint16_t telemetrySensorsVersion;
 
 #endif // _TELEMETRY_SENSORS_H_
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+
+// bit by bit CRC, MSB first, as a reference for the tables
+static uint16_t crcBitwise(uint16_t poly, uint8_t width, uint16_t crc, const uint8_t * buf, uint32_t len)
+{
+  uint16_t topbit = 1 << (width - 1);
+  uint16_t mask = (width == 16 ? 0xFFFF : (1 << width) - 1);
+  for (uint32_t i = 0; i < len; i++) {
+    crc ^= buf[i] << (width - 8);
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc & topbit) ? (crc << 1) ^ poly : (crc << 1);
+    }
+    crc &= mask;
+  }
+  return crc;
+}
+
+// the CRC_1189 table is the reflected CCITT one (poly 0x8408), used MSB first
+static uint16_t crc1189Reference(uint16_t crc, const uint8_t * buf, uint32_t len)
+{
+  for (uint32_t i = 0; i < len; i++) {
+    uint16_t value = ((crc >> 8) ^ buf[i]) & 0xFF;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      value = (value & 1) ? (value >> 1) ^ 0x8408 : (value >> 1);
+    }
+    crc = (crc << 8) ^ value;
+  }
+  return crc;
+}
+
+TEST(Crc, CheckValues)
+{
+  const uint8_t check[] = "123456789";
+  EXPECT_EQ(crc16(CRC_1021, check, 9), 0x31C3); // CRC-16/XMODEM
+  EXPECT_EQ(crc16(CRC_1021, check, 9, 0xFFFF), 0x29B1); // CRC-16/CCITT-FALSE
+  EXPECT_EQ(crc8(check, 0), 0);
+  EXPECT_EQ(crc16(CRC_1189, check, 0, 0x1234), 0x1234);
+}
+
+TEST(Crc, MatchesReference)
+{
+  uint8_t buffer[300];
+  for (unsigned i = 0; i < sizeof(buffer); i++) {
+    buffer[i] = rand();
+  }
+
+  const uint16_t starts[] = { 0x0000, 0xFFFF, 0x1234, 0xA5C3 };
+
+  for (uint32_t len = 0; len <= sizeof(buffer); len += (len < 70 ? 1 : 23)) {
+    for (uint16_t start: starts) {
+      EXPECT_EQ(crc8(buffer, len, start), crcBitwise(0xD5, 8, start & 0xFF, buffer, len));
+      EXPECT_EQ(crc8_BA(buffer, len, start), crcBitwise(0xBA, 8, start & 0xFF, buffer, len));
+      EXPECT_EQ(crc16(CRC_1021, buffer, len, start), crcBitwise(0x1021, 16, start, buffer, len));
+      EXPECT_EQ(crc16(CRC_1189, buffer, len, start), crc1189Reference(start, buffer, len));
+    }
+  }
+}
+
+TEST(Crc, Incremental)
+{
+  uint8_t buffer[64];
+  for (unsigned i = 0; i < sizeof(buffer); i++) {
+    buffer[i] = rand();
+  }
+
+  for (uint32_t split = 0; split <= sizeof(buffer); split++) {
+    uint32_t rest = sizeof(buffer) - split;
+    EXPECT_EQ(crc8(buffer + split, rest, crc8(buffer, split)), crc8(buffer, sizeof(buffer)));
+    EXPECT_EQ(crc8_BA(buffer + split, rest, crc8_BA(buffer, split)), crc8_BA(buffer, sizeof(buffer)));
+    EXPECT_EQ(crc16(CRC_1021, buffer + split, rest, crc16(CRC_1021, buffer, split)), crc16(CRC_1021, buffer, sizeof(buffer)));
+    EXPECT_EQ(crc16(CRC_1189, buffer + split, rest, crc16(CRC_1189, buffer, split)), crc16(CRC_1189, buffer, sizeof(buffer)));
+  }
+
+  // byte by byte, as in the PXX1 frames
+  uint16_t crc = 0;
+  for (unsigned i = 0; i < sizeof(buffer); i++) {
+    crc = crcUpdate<uint16_t>(crc16tab_1189, crc, buffer[i]);
+  }
+  EXPECT_EQ(crc, crc16(CRC_1189, buffer, sizeof(buffer)));
+}
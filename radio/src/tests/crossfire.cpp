@@ -43,5 +43,47 @@ TEST(Crossfire, crc8)
   uint8_t crc = crc8(&frame[2], frame[1]-1);
   ASSERT_EQ(frame[frame[1]+1], crc);
 }
+
+TEST(Crossfire, telemetryStreamInChunks)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  telemetryData.telemetryValid = 0x07;
+  allowNewSensors = true;
+  telemetryRxBufferCount = 0;
+
+  // battery frame: 24.0V, 1.0A, 500mAh, 80%
+  uint8_t frame[] = { RADIO_ADDRESS, 0x0A, BATTERY_ID, 0x00, 0xF0, 0x00, 0x0A, 0x00, 0x01, 0xF4, 0x50, 0x00 };
+  frame[11] = crc8(&frame[2], frame[1] - 1);
+
+  uint8_t stream[64];
+  uint32_t length = 0;
+  stream[length++] = 0x00; // garbage before the first frame
+  stream[length++] = 0x55;
+  memcpy(&stream[length], frame, sizeof(frame));
+  length += sizeof(frame);
+  memcpy(&stream[length], frame, sizeof(frame));
+  stream[length + 4] = 0xFF; // voltage changed, CRC not updated
+  length += sizeof(frame);
+
+  for (uint32_t i = 0; i < length; i += 5) {
+    processCrossfireTelemetryData(&stream[i], min<uint32_t>(5, length - i));
+  }
+
+  EXPECT_EQ(0, telemetryRxBufferCount);
+  EXPECT_EQ(240, telemetryItems[0].value);
+  EXPECT_EQ(10, telemetryItems[1].value);
+  EXPECT_EQ(500, telemetryItems[2].value);
+  EXPECT_EQ(80, telemetryItems[3].value);
+
+  // byte by byte delivery still works
+  frame[4] = 0xFA;
+  frame[11] = crc8(&frame[2], frame[1] - 1);
+  for (uint8_t byte: frame) {
+    processCrossfireTelemetryData(byte);
+  }
+  EXPECT_EQ(250, telemetryItems[0].value);
+}
 #endif
 
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <stdio.h>
+#include "gtests.h"
+
+#if defined(DISK_CACHE)
+
+#define TEST_DISK_SECTORS    (4 * DISK_CACHE_BLOCKS_NUM * DISK_CACHE_BLOCK_SECTORS)
+
+// each sector starts with its number, the rest of it is filled with the value
+static void fillTestSector(uint8_t * buffer, uint32_t sector, uint8_t value)
+{
+  memset(buffer, value, BLOCK_SIZE);
+  memcpy(buffer, &sector, sizeof(sector));
+}
+
+static void createTestDisk()
+{
+  FILE * image = fopen("sdcard.image", "wb");
+  ASSERT_TRUE(image != nullptr);
+  uint8_t buffer[BLOCK_SIZE];
+  for (uint32_t sector = 0; sector < TEST_DISK_SECTORS; sector++) {
+    fillTestSector(buffer, sector, sector);
+    ASSERT_EQ(1u, fwrite(buffer, BLOCK_SIZE, 1, image));
+  }
+  fclose(image);
+  ASSERT_EQ(0, disk_initialize(0));
+  ASSERT_EQ(uint32_t(TEST_DISK_SECTORS), sdGetNoSectors());
+  diskCache.clear();
+}
+
+static void checkTestSector(uint32_t sector, uint8_t value)
+{
+  uint8_t buffer[BLOCK_SIZE], expected[BLOCK_SIZE];
+  fillTestSector(expected, sector, value);
+  ASSERT_EQ(RES_OK, disk_read(0, buffer, sector, 1));
+  EXPECT_EQ(0, memcmp(expected, buffer, BLOCK_SIZE)) << "sector " << sector;
+}
+
+TEST(DiskCache, LeastRecentlyUsedBlockIsReplaced)
+{
+  createTestDisk();
+
+  // all the blocks are filled, each one starts at the sector that was read
+  for (uint32_t block = 0; block < DISK_CACHE_BLOCKS_NUM; block++) {
+    checkTestSector(block * DISK_CACHE_BLOCK_SECTORS, block * DISK_CACHE_BLOCK_SECTORS);
+  }
+  EXPECT_EQ(0u, diskCache.getStats().noHits);
+  EXPECT_EQ(uint32_t(DISK_CACHE_BLOCKS_NUM), diskCache.getStats().noMisses);
+
+  // the first block is used again, the second one is now the least recently used
+  checkTestSector(2, 2);
+  EXPECT_EQ(1u, diskCache.getStats().noHits);
+
+  // one more block replaces the second one
+  const uint32_t last = DISK_CACHE_BLOCKS_NUM * DISK_CACHE_BLOCK_SECTORS;
+  checkTestSector(last, last);
+  EXPECT_EQ(uint32_t(DISK_CACHE_BLOCKS_NUM + 1), diskCache.getStats().noMisses);
+
+  checkTestSector(3, 3);
+  EXPECT_EQ(2u, diskCache.getStats().noHits);
+  checkTestSector(DISK_CACHE_BLOCK_SECTORS + 1, DISK_CACHE_BLOCK_SECTORS + 1);
+  EXPECT_EQ(2u, diskCache.getStats().noHits);
+  EXPECT_EQ(uint32_t(DISK_CACHE_BLOCKS_NUM + 2), diskCache.getStats().noMisses);
+
+  // and the third block was the next one replaced
+  checkTestSector(2 * DISK_CACHE_BLOCK_SECTORS + 5, 2 * DISK_CACHE_BLOCK_SECTORS + 5);
+  EXPECT_EQ(uint32_t(DISK_CACHE_BLOCKS_NUM + 3), diskCache.getStats().noMisses);
+  checkTestSector(last + 1, last + 1);
+  EXPECT_EQ(3u, diskCache.getStats().noHits);
+
+  diskCache.clear();
+  remove("sdcard.image");
+}
+
+TEST(DiskCache, WriteThrough)
+{
+  createTestDisk();
+
+  // the cached block holds the sectors 4 to 19
+  checkTestSector(4, 4);
+  EXPECT_EQ(1u, diskCache.getStats().noMisses);
+
+  // a cached sector is written: the disk and the cached block are both updated
+  uint8_t buffer[BLOCK_SIZE];
+  fillTestSector(buffer, 5, 0xA5);
+  ASSERT_EQ(RES_OK, disk_write(0, buffer, 5, 1));
+  EXPECT_EQ(1u, diskCache.getStats().noWrites);
+  EXPECT_EQ(1u, diskCache.getStats().noWriteHits);
+
+  checkTestSector(5, 0xA5);
+  EXPECT_EQ(1u, diskCache.getStats().noHits);
+  EXPECT_EQ(1u, diskCache.getStats().noMisses);
+
+  uint8_t written[BLOCK_SIZE];
+  ASSERT_EQ(RES_OK, __disk_read(0, written, 5, 1));
+  EXPECT_EQ(0, memcmp(buffer, written, BLOCK_SIZE));
+
+  // a write across the end of the cached block: both sectors are on the disk
+  uint8_t buffers[2 * BLOCK_SIZE];
+  fillTestSector(buffers, 19, 0x5A);
+  fillTestSector(buffers + BLOCK_SIZE, 20, 0x5A);
+  ASSERT_EQ(RES_OK, disk_write(0, buffers, 19, 2));
+  EXPECT_EQ(2u, diskCache.getStats().noWrites);
+  EXPECT_EQ(2u, diskCache.getStats().noWriteHits);
+  checkTestSector(19, 0x5A);
+  EXPECT_EQ(2u, diskCache.getStats().noHits);
+  checkTestSector(20, 0x5A);
+  EXPECT_EQ(2u, diskCache.getStats().noMisses);
+
+  // an uncached sector is only written to the disk
+  fillTestSector(buffer, 10 * DISK_CACHE_BLOCK_SECTORS, 0x33);
+  ASSERT_EQ(RES_OK, disk_write(0, buffer, 10 * DISK_CACHE_BLOCK_SECTORS, 1));
+  EXPECT_EQ(3u, diskCache.getStats().noWrites);
+  EXPECT_EQ(2u, diskCache.getStats().noWriteHits);
+  checkTestSector(10 * DISK_CACHE_BLOCK_SECTORS, 0x33);
+  EXPECT_EQ(3u, diskCache.getStats().noMisses);
+
+  EXPECT_EQ(400, diskCache.getHitRate());
+
+  diskCache.clear();
+  remove("sdcard.image");
+}
+#endif
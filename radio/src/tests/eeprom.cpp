@@ -181,4 +181,87 @@ TEST(Eeprom, rm)
   }
   EXPECT_EQ(sz, 0);
 }
+
+TEST(Eeprom, streamingEncoder)
+{
+  uint8_t buf[1000];
+  uint8_t compressed[1100];
+  uint8_t streamed[1100];
+
+  for (int i = 0; i < 100; i++) {
+    int size = 1 + rand() % 800;
+    for (int j = 0; j < size; j++) {
+      buf[j] = rand() % 100 < i ? 0 : (j & 0xff);
+    }
+    unsigned int len = compress(compressed, sizeof(compressed), buf, size);
+
+    RlcEncoder encoder;
+    encoder.init(buf, size);
+    unsigned int pos = 0;
+    while (!encoder.isDone()) {
+      unsigned int count = encoder.encode(&streamed[pos], 1 + rand() % (BS - sizeof(blkid_t)));
+      ASSERT_NE(count, 0U);
+      pos += count;
+    }
+    EXPECT_EQ(pos, len);
+    EXPECT_EQ(memcmp(compressed, streamed, len), 0);
+  }
+}
+
+extern blkid_t freeBlocks;
+void eepromCheck();
+
+TEST(Eeprom, writesRotateBlocks)
+{
+  eepromFile = NULL; // in memory
+  uint8_t buf[300];
+  uint8_t buf2[300];
+
+  storageFormat();
+
+  blkid_t previousBlk = 0;
+  for (int i = 0; i < 50; i++) {
+    for (unsigned j = 0; j < sizeof(buf); j++) {
+      buf[j] = i + j;
+    }
+    theFile.writeRlc(5, 5, buf, sizeof(buf), true);
+    EXPECT_NE(eeFs.files[5].startBlk, previousBlk);
+    previousBlk = eeFs.files[5].startBlk;
+
+    theFile.openRlc(5);
+    EXPECT_EQ(theFile.readRlc(buf2, sizeof(buf2)), sizeof(buf));
+    EXPECT_EQ(memcmp(buf, buf2, sizeof(buf)), 0);
+  }
+
+  // no block lost or used twice
+  blkid_t blocks = freeBlocks;
+  eepromCheck();
+  EXPECT_EQ(freeBlocks, blocks);
+}
+
+TEST(Eeprom, unchangedModelNotWritten)
+{
+  eepromFile = NULL; // in memory
+  MODEL_RESET();
+
+  storageFormat();
+  g_eeGeneral.currModel = 0;
+  eepromWriteStats.reset();
+
+  storageDirty(EE_MODEL);
+  storageCheck(true);
+  EXPECT_EQ(eepromWriteStats.writes, 1);
+  EXPECT_EQ(eepromWriteStats.skipped, 0);
+
+  storageDirty(EE_MODEL);
+  storageCheck(true);
+  EXPECT_EQ(eepromWriteStats.writes, 1);
+  EXPECT_EQ(eepromWriteStats.skipped, 1);
+
+  g_model.extendedLimits = 1;
+  storageDirty(EE_MODEL);
+  storageCheck(true);
+  EXPECT_EQ(eepromWriteStats.writes, 2);
+  EXPECT_EQ(eepromWriteStats.skipped, 1);
+}
 #endif
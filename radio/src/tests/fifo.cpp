@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+
+TEST(Fifo, PushPop)
+{
+  Fifo<uint8_t, 4> fifo;
+  uint8_t element;
+
+  EXPECT_TRUE(fifo.isEmpty());
+  EXPECT_TRUE(fifo.push(1));
+  EXPECT_TRUE(fifo.push(2));
+  EXPECT_TRUE(fifo.push(3));
+  EXPECT_TRUE(fifo.isFull());
+  EXPECT_FALSE(fifo.push(4));
+  EXPECT_EQ(1u, fifo.getOverruns());
+
+  EXPECT_TRUE(fifo.pop(element));
+  EXPECT_EQ(1, element);
+  EXPECT_EQ(2u, fifo.size());
+
+  fifo.clear();
+  EXPECT_TRUE(fifo.isEmpty());
+  EXPECT_EQ(0u, fifo.getOverruns());
+}
+
+TEST(Fifo, BlocksWrapAround)
+{
+  Fifo<uint8_t, 8> fifo;
+  uint8_t input[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+  uint8_t output[9];
+
+  // move the indexes close to the end of the buffer
+  EXPECT_EQ(5u, fifo.pushBlock(input, 5));
+  EXPECT_EQ(5u, fifo.popBlock(output, 9));
+
+  // 7 elements fit, the last 2 ones are dropped
+  EXPECT_EQ(7u, fifo.pushBlock(input, 9));
+  EXPECT_EQ(2u, fifo.getOverruns());
+  EXPECT_EQ(7u, fifo.size());
+
+  EXPECT_EQ(3u, fifo.popBlock(output, 3));
+  EXPECT_EQ(4u, fifo.popBlock(output + 3, 9));
+  EXPECT_TRUE(fifo.isEmpty());
+  for (int i = 0; i < 7; i++) {
+    EXPECT_EQ(input[i], output[i]);
+  }
+}
@@ -496,3 +496,28 @@ TEST(FrSkySPORT, frskyCurrent)
   EXPECT_EQ(telemetryItems[0].valueMax, 505);
 }
 
+
+TEST(FrSky, SensorsSharingSameId)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  telemetryData.telemetryValid = 0x07;
+  allowNewSensors = true;
+
+  EXPECT_EQ(0, setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, T1_FIRST_ID, 0, 0, 100, UNIT_CELSIUS, 0));
+
+  // second sensor with the same id, added by an edit after the first value
+  g_model.telemetrySensors[1] = g_model.telemetrySensors[0];
+  storageDirty(EE_MODEL);
+
+  EXPECT_EQ(-1, setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, T1_FIRST_ID, 0, 0, 200, UNIT_CELSIUS, 0));
+  EXPECT_EQ(telemetryItems[0].value, 200);
+  EXPECT_EQ(telemetryItems[1].value, 200);
+
+  // second sensor moved to another id without any notification
+  g_model.telemetrySensors[1].id = T1_FIRST_ID + 1;
+  EXPECT_EQ(-1, setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, T1_FIRST_ID + 1, 0, 0, 300, UNIT_CELSIUS, 0));
+  EXPECT_EQ(telemetryItems[0].value, 200);
+  EXPECT_EQ(telemetryItems[1].value, 300);
+}
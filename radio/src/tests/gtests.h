@@ -64,6 +64,7 @@ inline void MODEL_RESET()
 {
   memset(&g_model, 0, sizeof(g_model));
   memset(&anaInValues, 0, sizeof(anaInValues));
+  invalidateCurveTangents();
   extern uint8_t s_mixer_first_run_done;
   s_mixer_first_run_done = false;
   evalMixes(1);  // this is needed to reset fp_act
@@ -90,6 +91,7 @@ inline void TELEMETRY_RESET()
     telemetryItems[i].clear();
   }
   memclear(g_model.telemetrySensors, sizeof(g_model.telemetrySensors));
+  invalidateTelemetrySensorsIndex();
 }
 
 class OpenTxTest : public testing::Test 
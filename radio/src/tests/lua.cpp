@@ -20,6 +20,7 @@
 
 #include <math.h>
 #include "gtests.h"
+#include "location.h"
 
 #if defined(LUA)
 
@@ -163,4 +164,154 @@ TEST(Lua, testModelInputs)
 
 }
 
+TEST(Lua, testGetSourceIndex)
+{
+  MODEL_RESET();
+  storageDirty(EE_MODEL);
+
+  luaExecStr("for _, name in ipairs({'rud', 'max', 'trim-ail', 'input1', 'ch1', 'ch16', 'ls1'}) do "
+             "  if getSourceIndex(name) ~= getFieldInfo(name).id then error(name) end "
+             "end");
+  luaExecStr("for _, name in ipairs({'ch0', 'ch', 'ch100', 'unknown', 'Alt'}) do "
+             "  if getSourceIndex(name) ~= nil then error(name) end "
+             "end");
+  luaExecStr("if getValue('Alt') ~= 0 then error('getValue()') end");
+
+  // a sensor found after the name was looked up
+  strncpy(g_model.telemetrySensors[2].label, "Alt", TELEM_LABEL_LEN);
+  storageDirty(EE_MODEL);
+
+  char str[64];
+  snprintf(str, sizeof(str), "if getSourceIndex('Alt') ~= %d then error('Alt') end", MIXSRC_FIRST_TELEM + 3 * 2);
+  luaExecStr(str);
+  snprintf(str, sizeof(str), "if getSourceIndex('Alt+') ~= %d then error('Alt+') end", MIXSRC_FIRST_TELEM + 3 * 2 + 2);
+  luaExecStr(str);
+
+  MODEL_RESET();
+  storageDirty(EE_MODEL);
+}
+
+#if LUA_SCRIPT_MEM_MAX > 0
+TEST(Lua, testScriptMemoryLimit)
+{
+  luaInit();
+  ASSERT_TRUE(lsScripts != nullptr);
+
+  LuaScriptMemory greedy, other;
+  luaAddScriptMemory(lsScriptsMemory, greedy, 32 * 1024);
+  luaAddScriptMemory(lsScriptsMemory, other, 32 * 1024);
+
+  lsScriptsMemory.running = &greedy;
+  ASSERT_EQ(LUA_OK, luaL_loadstring(lsScripts, "t = {} for i = 1, 100000 do t[i] = i end"));
+  EXPECT_EQ(LUA_ERRMEM, lua_pcall(lsScripts, 0, 0, 0));
+  lua_pop(lsScripts, 1);
+  EXPECT_GE(32u * 1024, greedy.used);
+
+  // the other scripts keep running, and get back the memory they free
+  lsScriptsMemory.running = &other;
+  for (int i = 0; i < 100; i++) {
+    luaExecStr("local s = '' for i = 1, 100 do s = s .. i end");
+  }
+  lsScriptsMemory.running = nullptr;
+  lua_gc(lsScripts, LUA_GCCOLLECT, 0);
+  EXPECT_GT(4u * 1024, other.used);
+
+  luaRemoveScriptMemory(lsScriptsMemory, greedy);
+  luaRemoveScriptMemory(lsScriptsMemory, other);
+  luaInit();
+}
+#endif
+
+TEST(Lua, testSuspendedMixScript)
+{
+  // getUsage() starts again from 0 each time the run is resumed
+  static const char script[] =
+    "local function run()\n"
+    "  local resumed, last = 0, 0\n"
+    "  while resumed < 3 do\n"
+    "    local usage = getUsage()\n"
+    "    if usage < last then resumed = resumed + 1 end\n"
+    "    last = usage\n"
+    "  end\n"
+    "  return resumed\n"
+    "end\n"
+    "return { output = { 'Out' }, run = run }\n";
+  simuFatfsSetPaths(TESTS_BUILD_PATH, TESTS_BUILD_PATH);
+  sdCheckAndCreateDirectory(SCRIPTS_PATH);
+  sdCheckAndCreateDirectory(SCRIPTS_MIXES_PATH);
+
+  FIL file;
+  UINT written;
+  ASSERT_EQ(FR_OK, f_open(&file, SCRIPTS_MIXES_PATH "/slow" SCRIPT_EXT, FA_CREATE_ALWAYS | FA_WRITE));
+  ASSERT_EQ(FR_OK, f_write(&file, script, sizeof(script) - 1, &written));
+  f_close(&file);
+
+  MODEL_RESET();
+  strncpy(g_model.scriptsData[0].file, "slow", LEN_SCRIPT_FILENAME);
+  LUA_LOAD_MODEL_SCRIPTS();
+
+  // the first run is out of time and suspended
+  luaTask(0, RUN_MIX_SCRIPT, false);
+  ASSERT_EQ(SCRIPT_OK, scriptInternalData[0].state);
+  EXPECT_NE(0, scriptInternalData[0].thread);
+  EXPECT_EQ(0, scriptInputsOutputs[0].outputs[0].value);
+
+  // then resumed at the next cycles until it ends
+  int cycles = 1;
+  while (cycles < 10 && scriptInternalData[0].thread) {
+    luaTask(0, RUN_MIX_SCRIPT, false);
+    ASSERT_EQ(SCRIPT_OK, scriptInternalData[0].state);
+    cycles++;
+  }
+  EXPECT_EQ(4, cycles);
+  EXPECT_EQ(3, scriptInputsOutputs[0].outputs[0].value);
+  EXPECT_LT(0, luaGetCpuTime(0));
+
+  MODEL_RESET();
+  LUA_LOAD_MODEL_SCRIPTS();
+  f_unlink(SCRIPTS_MIXES_PATH "/slow" SCRIPT_EXT);
+}
+
+#if defined(LUA_COMPILER)
+TEST(Lua, testCompileScriptsWhenIdle)
+{
+  static const char script[] = "return { run = function() return 1 end }\n";
+  simuFatfsSetPaths(TESTS_BUILD_PATH, TESTS_BUILD_PATH);
+  sdCheckAndCreateDirectory(SCRIPTS_PATH);
+  sdCheckAndCreateDirectory(SCRIPTS_MIXES_PATH);
+  f_unlink(SCRIPTS_MIXES_PATH "/cache" SCRIPT_BIN_EXT);
+
+  FIL file;
+  UINT written;
+  ASSERT_EQ(FR_OK, f_open(&file, SCRIPTS_MIXES_PATH "/cache" SCRIPT_EXT, FA_CREATE_ALWAYS | FA_WRITE));
+  ASSERT_EQ(FR_OK, f_write(&file, script, sizeof(script) - 1, &written));
+  f_close(&file);
+
+  luaInit();
+  luaState = 0;
+
+  // nothing is compiled while the radio is in use
+  inactivity.counter = 0;
+  luaCompileNextScript();
+  EXPECT_FALSE(isFileAvailable(SCRIPTS_MIXES_PATH "/cache" SCRIPT_BIN_EXT));
+
+  // nor while the model may be flying
+  inactivity.counter = 10;
+  timersStates[0].state = TMR_RUNNING;
+  luaCompileNextScript();
+  luaCompileNextScript();
+  EXPECT_FALSE(isFileAvailable(SCRIPTS_MIXES_PATH "/cache" SCRIPT_BIN_EXT));
+
+  timersStates[0].state = TMR_OFF;
+  for (int i = 0; i < 100; i++) {
+    luaCompileNextScript();
+  }
+  EXPECT_TRUE(isFileAvailable(SCRIPTS_MIXES_PATH "/cache" SCRIPT_BIN_EXT));
+
+  f_unlink(SCRIPTS_MIXES_PATH "/cache" SCRIPT_BIN_EXT);
+  f_unlink(SCRIPTS_MIXES_PATH "/cache" SCRIPT_EXT);
+  inactivity.counter = 0;
+}
+#endif
+
 #endif   // #if defined(LUA)
@@ -476,6 +476,55 @@ TEST(Curves, LinearIntpol)
   EXPECT_EQ(applyCustomCurve(-192, 0), -192);
 }
 
+TEST(Curves, SmoothTangentsCache)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+  setModelDefaults(0);
+
+  // curve 1: 9 points standard, curve 2: 5 points custom
+  static const int8_t points[] = { -100, -80, -20, 0, 10, 60, 100, 90, 100,
+                                   -50, 20, 30, 100, 0, -40, 30, 60 };
+  g_model.curves[0].points = 4;
+  g_model.curves[0].smooth = 1;
+  g_model.curves[1].type = CURVE_TYPE_CUSTOM;
+  g_model.curves[1].smooth = 1;
+  memcpy(g_model.points, points, sizeof(points));
+  loadCurves();
+
+  // values computed with the tangents computed at each evaluation, every 128 from -RESX
+  static const int expected[2][17] = {
+    { -1024, -947, -819, -512, -205, -70, 0, 31, 102, 338, 614, 876, 1024, 973, 922, 960, 1024 },
+    { -512, -347, -167, 2, 137, 215, 247, 255, 255, 262, 288, 437, 848, 1016, 790, 388, 0 },
+  };
+
+  // the first pass fills the cache, the second one uses it
+  for (int pass = 0; pass < 2; pass++) {
+    for (uint8_t idx = 0; idx < 2; idx++) {
+      for (int i = 0; i < 17; i++) {
+        int x = -RESX + i * 128;
+        EXPECT_EQ(expected[idx][i], applyCustomCurve(x, idx)) << "curve " << int(idx) << " x=" << x;
+      }
+    }
+  }
+
+  // a model change is seen by the next evaluation
+  EXPECT_EQ(RESX, applyCustomCurve(RESX, 0));
+  g_model.points[8] = -100;
+  storageDirty(EE_MODEL);
+  EXPECT_EQ(-RESX, applyCustomCurve(RESX, 0));
+
+  // even when the mixer runs between storageDirty() and the edit
+  storageDirty(EE_MODEL);
+  applyCustomCurve(RESX / 8, 0);
+  g_model.points[5] = 0;
+  invalidateEditedCurveTangents();
+  int edited = applyCustomCurve(RESX / 8, 0);
+  invalidateCurveTangents();
+  EXPECT_EQ(applyCustomCurve(RESX / 8, 0), edited);
+}
+
 
 
 TEST_F(MixerTest, InfiniteRecursiveChannels)
@@ -522,6 +571,34 @@ TEST_F(MixerTest, RecursiveAddChannel)
   EXPECT_EQ(chans[1], 0);
 }
 
+TEST_F(MixerTest, RecursiveChannelUnsortedMixes)
+{
+  // CH3 lines on both sides of a CH1 line using CH4
+  g_model.mixData[0].destCh = 2;
+  g_model.mixData[0].srcRaw = MIXSRC_MAX;
+  g_model.mixData[0].weight = 50;
+  g_model.mixData[1].destCh = 0;
+  g_model.mixData[1].srcRaw = MIXSRC_CH4;
+  g_model.mixData[1].weight = 100;
+  g_model.mixData[2].destCh = 2;
+  g_model.mixData[2].srcRaw = MIXSRC_MAX;
+  g_model.mixData[2].weight = 25;
+  g_model.mixData[3].destCh = 3;
+  g_model.mixData[3].srcRaw = MIXSRC_MAX;
+  g_model.mixData[3].weight = 25;
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(chans[0], CHANNEL_MAX/4);
+  EXPECT_EQ(chans[2], CHANNEL_MAX/4);
+  EXPECT_EQ(chans[3], CHANNEL_MAX/4);
+
+  // the third line edited in place to add to CH1
+  g_model.mixData[2].destCh = 0;
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(chans[0], CHANNEL_MAX/2);
+  EXPECT_EQ(chans[2], CHANNEL_MAX/2);
+  EXPECT_EQ(chans[3], CHANNEL_MAX/4);
+}
+
 TEST_F(MixerTest, RecursiveAddChannelAfterInactivePhase)
 {
   g_model.flightModeData[1].swtch = SWSRC_ID1;
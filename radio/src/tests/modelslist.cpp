@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+#include "storage/modelslist.h"
+#include "storage/sdcard_common.h"
+#include "location.h"
+
+#if defined(SDCARD_RAW)
+static void writeTestModel(const char * filename, const char * name, uint8_t modelId)
+{
+  char path[256];
+  getModelPath(path, filename);
+  memclear(&g_model, sizeof(g_model));
+  strncpy(g_model.header.name, name, LEN_MODEL_NAME);
+  g_model.header.modelId[EXTERNAL_MODULE] = modelId;
+  EXPECT_EQ(nullptr, writeFile(path, (uint8_t *)&g_model, sizeof(g_model)));
+}
+
+static void setTestModelDate(const char * filename, uint16_t date)
+{
+  char path[256];
+  getModelPath(path, filename);
+  FILINFO info;
+  memclear(&info, sizeof(info));
+  info.fdate = date;
+  info.ftime = 12 << 11; // 12:00:00
+  EXPECT_EQ(FR_OK, f_utime(path, &info));
+}
+
+static const ModelCell * findTestModel(const char * filename)
+{
+  for (auto * category: modelslist.getCategories()) {
+    for (auto * model: *category) {
+      if (!strcmp(model->modelFilename, filename))
+        return model;
+    }
+  }
+  return nullptr;
+}
+
+TEST(ModelsList, CacheSkipsUnchangedModels)
+{
+  simuFatfsSetPaths(TESTS_BUILD_PATH, TESTS_BUILD_PATH);
+  sdCheckAndCreateDirectory(RADIO_PATH);
+  sdCheckAndCreateDirectory(MODELS_PATH);
+  f_unlink(RADIO_MODELSCACHE_PATH);
+
+  const uint16_t date1 = ((2021 - 1980) << 9) | (1 << 5) | 1;
+  const uint16_t date2 = ((2021 - 1980) << 9) | (2 << 5) | 1;
+  const uint16_t future = ((2099 - 1980) << 9) | (1 << 5) | 1;
+
+  writeTestModel("model1.bin", "Model1", 1);
+  writeTestModel("model2.bin", "Model2", 2);
+  writeTestModel("model3.bin", "Model3", 3);
+  setTestModelDate("model1.bin", date1);
+  setTestModelDate("model2.bin", future);
+  setTestModelDate("model3.bin", date1);
+
+  FIL file;
+  ASSERT_EQ(FR_OK, f_open(&file, RADIO_MODELSLIST_PATH, FA_CREATE_ALWAYS | FA_WRITE));
+  f_puts("[Models]\nmodel1.bin\nmodel2.bin\nmodel3.bin\n", &file);
+  f_close(&file);
+
+  // first load: all models are read and the cache is created
+  modelslist.clear();
+  modelslist.load();
+  EXPECT_EQ(3u, modelslist.getModelsCount());
+  EXPECT_STREQ("Model2", findTestModel("model2.bin")->modelName);
+  EXPECT_EQ(2, findTestModel("model2.bin")->modelId[EXTERNAL_MODULE]);
+  EXPECT_EQ(FR_OK, f_stat(RADIO_MODELSCACHE_PATH, nullptr));
+
+  // same size and date, older than the cache: served from the cache, the new bytes are not read
+  writeTestModel("model1.bin", "Changed", 4);
+  setTestModelDate("model1.bin", date1);
+
+  // same size and date, not older than the cache: read again
+  writeTestModel("model2.bin", "Edited", 6);
+  setTestModelDate("model2.bin", future);
+
+  // new date: the cache entry is stale
+  writeTestModel("model3.bin", "Renamed", 5);
+  setTestModelDate("model3.bin", date2);
+
+  modelslist.clear();
+  modelslist.load();
+  EXPECT_STREQ("Model1", findTestModel("model1.bin")->modelName);
+  EXPECT_EQ(1, findTestModel("model1.bin")->modelId[EXTERNAL_MODULE]);
+  EXPECT_STREQ("Edited", findTestModel("model2.bin")->modelName);
+  EXPECT_EQ(6, findTestModel("model2.bin")->modelId[EXTERNAL_MODULE]);
+  EXPECT_STREQ("Renamed", findTestModel("model3.bin")->modelName);
+  EXPECT_EQ(5, findTestModel("model3.bin")->modelId[EXTERNAL_MODULE]);
+  EXPECT_TRUE(findTestModel("model3.bin")->valid_rfData);
+
+  modelslist.clear();
+  f_unlink(RADIO_MODELSCACHE_PATH);
+  f_unlink(RADIO_MODELSLIST_PATH);
+}
+#endif
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+
+TEST(StrHelpers, strAppendUnsigned)
+{
+  char buffer[16];
+
+  EXPECT_EQ(buffer + 1, strAppendUnsigned(buffer, 0));
+  EXPECT_STREQ("0", buffer);
+
+  strAppendUnsigned(buffer, 1234567);
+  EXPECT_STREQ("1234567", buffer);
+
+  strAppendUnsigned(buffer, 42, 4);
+  EXPECT_STREQ("0042", buffer);
+
+  strAppendUnsigned(buffer, 4294967295u);
+  EXPECT_STREQ("4294967295", buffer);
+}
+
+TEST(StrHelpers, strAppendUnsignedHex)
+{
+  char buffer[16];
+
+  strAppendUnsigned(buffer, 0x1A2B, 8, 16);
+  EXPECT_STREQ("00001A2B", buffer);
+
+  // logical switches states in the logs, with switch 32 on
+  strAppendUnsigned(buffer, 0x80000000, 8, 16);
+  EXPECT_STREQ("80000000", buffer);
+
+  strAppendUnsigned(buffer, 0xFFFFFFFF, 8, 16);
+  EXPECT_STREQ("FFFFFFFF", buffer);
+
+  char * s = strAppend(buffer, "0x");
+  s = strAppendUnsigned(s, 0x80000001, 8, 16);
+  strAppendUnsigned(s, 0x00000080, 8, 16);
+  EXPECT_STREQ("0x8000000100000080", buffer);
+}
@@ -66,6 +66,42 @@ TEST(getSwitch, OldTypeStickyCSW)
 }
 #endif
 
+#if defined(PCBTARANIS)
+TEST(getSwitch, delayEditedOut)
+{
+  RADIO_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+
+  setLogicalSwitch(0, LS_FUNC_AND, SWSRC_SA0, SWSRC_NONE, 0, 10);
+
+  simuSetSwitch(0, -1);
+  for (int i = 0; i < 5; i++) {
+    evalLogicalSwitches();
+    EXPECT_EQ(getSwitch(SWSRC_SW1), false);
+    logicalSwitchesTimerTick();
+  }
+
+  // delay removed half way
+  g_model.logicalSw[0].delay = 0;
+  logicalSwitchesTimerTick();
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), true);
+
+  // delay set again, the whole delay is waited for
+  g_model.logicalSw[0].delay = 10;
+  for (int i = 0; i < 10; i++) {
+    evalLogicalSwitches();
+    EXPECT_EQ(getSwitch(SWSRC_SW1), false);
+    logicalSwitchesTimerTick();
+  }
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), true);
+
+  simuSetSwitch(0, 0);
+}
+#endif
+
 TEST(getSwitch, nullSW)
 {
   MODEL_RESET();
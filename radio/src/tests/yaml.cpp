@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <chrono>
+#include <string>
+#include "gtests.h"
+#include "storage/sdcard_common.h"
+#include "location.h"
+
+#if defined(SDCARD_YAML)
+#define YAML_BENCHMARK_LOOPS 20
+
+TEST(Yaml, ModelLoadBenchmark)
+{
+  simuFatfsSetPaths(TESTS_BUILD_PATH, TESTS_BUILD_PATH);
+  sdCheckAndCreateDirectory(MODELS_PATH);
+
+  // a model using all the mixes and sensors
+  MODEL_RESET();
+  strncpy(g_model.header.name, "Benchmark", LEN_MODEL_NAME);
+  for (int i = 0; i < MAX_MIXERS; i++) {
+    MixData & mix = g_model.mixData[i];
+    mix.destCh = i % MAX_OUTPUT_CHANNELS;
+    mix.srcRaw = MIXSRC_Rud + (i % NUM_STICKS);
+    mix.weight = 100 - i;
+    mix.offset = i;
+  }
+  for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+    TelemetrySensor & sensor = g_model.telemetrySensors[i];
+    sensor.id = 0x0100 + i;
+    sensor.instance = i;
+    sensor.unit = UNIT_VOLTS;
+    sensor.prec = 1;
+    strncpy(sensor.label, "Sens", TELEM_LABEL_LEN);
+  }
+
+  strncpy(g_eeGeneral.currModelFilename, "benchmark.yml", LEN_MODEL_FILENAME);
+  ASSERT_EQ(nullptr, writeModel());
+
+  static ModelData saved;
+  saved = g_model;
+
+  uint8_t version;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < YAML_BENCHMARK_LOOPS; i++) {
+    ASSERT_EQ(nullptr, readModel("benchmark.yml", (uint8_t *)&g_model, sizeof(g_model), &version));
+  }
+  auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+  printf("YAML model load: %d us\n", int(duration.count() / YAML_BENCHMARK_LOOPS));
+
+  EXPECT_EQ(0, strncmp("Benchmark", g_model.header.name, LEN_MODEL_NAME));
+  EXPECT_EQ(0, memcmp(saved.mixData, g_model.mixData, sizeof(g_model.mixData)));
+  for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+    EXPECT_EQ(saved.telemetrySensors[i].id, g_model.telemetrySensors[i].id);
+  }
+
+  char path[256];
+  getModelPath(path, "benchmark.yml");
+  f_unlink(path);
+}
+
+static std::string readTestFile(const char * path)
+{
+  std::string content;
+  FIL file;
+  if (f_open(&file, path, FA_OPEN_EXISTING | FA_READ) == FR_OK) {
+    char buffer[256];
+    UINT count;
+    while (f_read(&file, buffer, sizeof(buffer), &count) == FR_OK && count > 0) {
+      content.append(buffer, count);
+    }
+    f_close(&file);
+  }
+  return content;
+}
+
+static void writeTestFile(const char * path, const std::string & content)
+{
+  FIL file;
+  UINT written;
+  ASSERT_EQ(FR_OK, f_open(&file, path, FA_CREATE_ALWAYS | FA_WRITE));
+  ASSERT_EQ(FR_OK, f_write(&file, content.data(), content.size(), &written));
+  f_close(&file);
+}
+
+static void setTestFileDate(const char * path)
+{
+  FILINFO info;
+  memclear(&info, sizeof(info));
+  info.fdate = ((2001 - 1980) << 9) | (1 << 5) | 1; // 2001-01-01
+  info.ftime = 12 << 11; // 12:00:00
+  EXPECT_EQ(FR_OK, f_utime(path, &info));
+}
+
+static uint16_t getTestFileDate(const char * path)
+{
+  FILINFO info;
+  EXPECT_EQ(FR_OK, f_stat(path, &info));
+  return info.fdate;
+}
+
+TEST(Yaml, WriteOnlyChangedModel)
+{
+  simuFatfsSetPaths(TESTS_BUILD_PATH, TESTS_BUILD_PATH);
+  sdCheckAndCreateDirectory(MODELS_PATH);
+
+  MODEL_RESET();
+  strncpy(g_model.header.name, "Unchanged", LEN_MODEL_NAME);
+  strncpy(g_eeGeneral.currModelFilename, "unchanged.yml", LEN_MODEL_FILENAME);
+  char path[256];
+  getModelPath(path, "unchanged.yml");
+  f_unlink(path);
+  ASSERT_EQ(nullptr, writeModel());
+  const std::string saved = readTestFile(path);
+  ASSERT_FALSE(saved.empty());
+
+  // an unchanged model is not written again
+  setTestFileDate(path);
+  uint16_t date = getTestFileDate(path);
+  ASSERT_EQ(nullptr, writeModel());
+  EXPECT_EQ(date, getTestFileDate(path));
+  EXPECT_EQ(saved, readTestFile(path));
+
+  // a file which differs by one byte, is longer or is shorter is written
+  std::string changed = saved;
+  changed[changed.size() / 2] ^= 0x01;
+  const std::string files[] = { changed, saved + "\n", saved.substr(0, saved.size() - 1) };
+  for (auto & file: files) {
+    writeTestFile(path, file);
+    setTestFileDate(path);
+    ASSERT_EQ(nullptr, writeModel());
+    EXPECT_NE(date, getTestFileDate(path));
+    EXPECT_EQ(saved, readTestFile(path));
+  }
+
+  // as well as a model changed by one byte
+  g_model.header.name[0] = 'u';
+  setTestFileDate(path);
+  ASSERT_EQ(nullptr, writeModel());
+  EXPECT_NE(date, getTestFileDate(path));
+  std::string expected = saved;
+  expected[expected.find("Unchanged")] = 'u';
+  EXPECT_EQ(expected, readTestFile(path));
+
+  f_unlink(path);
+}
+#endif
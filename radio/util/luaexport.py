@@ -137,8 +137,10 @@ with open(outputFile, "w") as out:
 
     out.write("""
     // The list of Lua fields that have a range of values
+    // this array is alphabetically sorted by the second field (name prefix)
     const LuaMultipleField luaMultipleFields[] = {
     """)
+    exports_multiple.sort(key=lambda x: x[1])  # sort by name prefix
     data = ["    {%s, \"%s\", \"%s\", %d}" % export for export in exports_multiple]
     out.write(",\n".join(data))
     out.write("\n};\n\n")